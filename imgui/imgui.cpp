@@ -4106,6 +4106,7 @@ ImGuiContext::ImGuiContext(ImFontAtlas* shared_font_atlas)
     DebugItemPickerBreakId = 0;
     DebugFlashStyleColorTime = 0.0f;
     DebugFlashStyleColorIdx = ImGuiCol_COUNT;
+    DebugAllocHookSuspended = 0;
 
     // Same as DebugBreakClearData(). Those fields are scattered in their respective subsystem to stay in hot-data locations
     DebugBreakInWindow = 0;
@@ -4776,7 +4777,8 @@ void* ImGui::MemAlloc(size_t size)
     void* ptr = (*GImAllocatorAllocFunc)(size, GImAllocatorUserData);
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
     if (ImGuiContext* ctx = GImGui)
-        DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, size);
+        if (ctx->DebugAllocHookSuspended == 0)
+            DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, size);
 #endif
     return ptr;
 }
@@ -4787,7 +4789,8 @@ void ImGui::MemFree(void* ptr)
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
     if (ptr != NULL)
         if (ImGuiContext* ctx = GImGui)
-            DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, (size_t)-1);
+            if (ctx->DebugAllocHookSuspended == 0)
+                DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, (size_t)-1);
 #endif
     return (*GImAllocatorFreeFunc)(ptr, GImAllocatorUserData);
 }
@@ -10668,6 +10671,8 @@ IM_MSVC_RUNTIME_CHECKS_RESTORE
 // - GetContentRegionAvail(),
 // - BeginGroup()
 // - EndGroup()
+// - BeginCachedDraw()
+// - EndCachedDraw()
 // Also see in imgui_widgets: tab bars, and in imgui_tables: tables, columns.
 //-----------------------------------------------------------------------------
 
@@ -11070,6 +11075,68 @@ void ImGui::EndGroup()
 }
 
 
+// Retained drawing: replay the geometry of a scope of non-interactive items while its hash is unchanged (see ImDrawList::BeginCachedSegment()),
+// then move the cursor as its items would have. Everything the layout of those items depends on is mixed into the hash, so replayed
+// positions are exactly those the items would have been submitted at.
+bool ImGui::BeginCachedDraw(ImGuiDrawCache* cache, ImU32 hash)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    if (window->SkipItems)
+        return false;
+
+    hash = ImHashData(&window->DC.CursorPos, sizeof(window->DC.CursorPos), hash);
+    hash = ImHashData(&window->DC.CursorPosPrevLine, sizeof(window->DC.CursorPosPrevLine), hash);
+    hash = ImHashData(&window->DC.CurrLineSize, sizeof(window->DC.CurrLineSize), hash);
+    hash = ImHashData(&window->DC.CurrLineTextBaseOffset, sizeof(window->DC.CurrLineTextBaseOffset), hash);
+    hash = ImHashData(&window->DC.IsSameLine, sizeof(window->DC.IsSameLine), hash);
+    hash = ImHashData(&window->DC.Indent, sizeof(window->DC.Indent), hash);
+    hash = ImHashData(&window->DC.TextWrapPos, sizeof(window->DC.TextWrapPos), hash);
+    hash = ImHashData(&window->WorkRect, sizeof(window->WorkRect), hash);
+    hash = ImHashData(&window->ClipRect, sizeof(window->ClipRect), hash);
+    hash = ImHashData(&g.Font, sizeof(g.Font), hash);
+    hash = ImHashData(&g.FontSize, sizeof(g.FontSize), hash);
+    hash = ImHashData(&g.Style.Alpha, sizeof(g.Style.Alpha), hash);
+
+    if (window->DrawList->BeginCachedSegment(&cache->DrawCache, hash))
+    {
+        // Measure the extent of the scope alone, what comes before it may change without changing the hash
+        cache->_RecCursorMaxPos = window->DC.CursorMaxPos;
+        window->DC.CursorMaxPos = ImVec2(-FLT_MAX, -FLT_MAX);
+        return true;
+    }
+
+    window->DC.CursorPos = cache->_CursorPos;
+    window->DC.CursorPosPrevLine = cache->_CursorPosPrevLine;
+    window->DC.CursorMaxPos = ImMax(window->DC.CursorMaxPos, cache->_CursorMaxPos);
+    window->DC.CurrLineSize = cache->_CurrLineSize;
+    window->DC.PrevLineSize = cache->_PrevLineSize;
+    window->DC.CurrLineTextBaseOffset = cache->_CurrLineTextBaseOffset;
+    window->DC.PrevLineTextBaseOffset = cache->_PrevLineTextBaseOffset;
+    window->DC.IsSameLine = cache->_IsSameLine;
+    window->DC.IsSetPos = cache->_IsSetPos;
+    return false;
+}
+
+void ImGui::EndCachedDraw(ImGuiDrawCache* cache)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    window->DrawList->EndCachedSegment(&cache->DrawCache);
+
+    cache->_CursorPos = window->DC.CursorPos;
+    cache->_CursorPosPrevLine = window->DC.CursorPosPrevLine;
+    cache->_CursorMaxPos = window->DC.CursorMaxPos;
+    window->DC.CursorMaxPos = ImMax(cache->_RecCursorMaxPos, cache->_CursorMaxPos);
+    cache->_CurrLineSize = window->DC.CurrLineSize;
+    cache->_PrevLineSize = window->DC.PrevLineSize;
+    cache->_CurrLineTextBaseOffset = window->DC.CurrLineTextBaseOffset;
+    cache->_PrevLineTextBaseOffset = window->DC.PrevLineTextBaseOffset;
+    cache->_IsSameLine = window->DC.IsSameLine;
+    cache->_IsSetPos = window->DC.IsSetPos;
+}
+
+
 //-----------------------------------------------------------------------------
 // [SECTION] SCROLLING
 //-----------------------------------------------------------------------------
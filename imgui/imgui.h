@@ -46,7 +46,7 @@ Index of this file:
 // [SECTION] Misc data structures (ImGuiInputTextCallbackData, ImGuiSizeCallbackData, ImGuiPayload)
 // [SECTION] Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiStorage, ImGuiListClipper, Math Operators, ImColor)
 // [SECTION] Multi-Select API flags and structures (ImGuiMultiSelectFlags, ImGuiMultiSelectIO, ImGuiSelectionRequest, ImGuiSelectionBasicStorage, ImGuiSelectionExternalStorage)
-// [SECTION] Drawing API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawFlags, ImDrawListFlags, ImDrawList, ImDrawData)
+// [SECTION] Drawing API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawListCache, ImDrawFlags, ImDrawListFlags, ImDrawList, ImDrawData)
 // [SECTION] Font API (ImFontConfig, ImFontGlyph, ImFontGlyphRangesBuilder, ImFontAtlasFlags, ImFontAtlas, ImFont)
 // [SECTION] Viewports (ImGuiViewportFlags, ImGuiViewport)
 // [SECTION] ImGuiPlatformIO + other Platform Dependent Interfaces (ImGuiPlatformImeData)
@@ -164,6 +164,9 @@ struct ImDrawCmd;                   // A single draw command within a parent ImD
 struct ImDrawData;                  // All draw command lists required to render the frame + pos/size coordinates to use for the projection matrix.
 struct ImDrawList;                  // A single draw command list (generally one per window, conceptually you may see this as a dynamic "mesh" builder)
 struct ImDrawListSharedData;        // Data shared among multiple draw lists (typically owned by parent ImGui context, but you may create one yourself)
+struct ImDrawInstanceShape;         // Filled shape tessellated once, then stamped out many times (see ImDrawList::AddShapeInstances())
+struct ImDrawListParallel;          // Helper to build draw lists on worker threads, then append them in a defined order.
+struct ImDrawListCache;             // Geometry a scope of a draw list submitted on an earlier frame, replayed while its hash is unchanged (see ImDrawList::BeginCachedSegment())
 struct ImDrawListSplitter;          // Helper to split a draw list into different layers which can be drawn into out of order, then flattened back.
 struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
@@ -176,6 +179,7 @@ struct ImColor;                     // Helper functions to create a color that c
 
 // Forward declarations: ImGui layer
 struct ImGuiContext;                // Dear ImGui context (opaque structure, unless including imgui_internal.h)
+struct ImGuiDrawCache;              // Geometry and layout of a scope of non-interactive items, replayed while its hash is unchanged (see BeginCachedDraw())
 struct ImGuiIO;                     // Main configuration and I/O between your application and ImGui (also see: ImGuiPlatformIO)
 struct ImGuiInputTextCallbackData;  // Shared state of InputText() when using custom ImGuiInputTextCallback (rare/advanced use)
 struct ImGuiKeyData;                // Storage for ImGuiIO and IsKeyDown(), IsKeyPressed() etc functions.
@@ -906,6 +910,17 @@ namespace ImGui
     IMGUI_API void          PushClipRect(const ImVec2& clip_rect_min, const ImVec2& clip_rect_max, bool intersect_with_current_clip_rect);
     IMGUI_API void          PopClipRect();
 
+    // Retained Drawing [BETA API]
+    // - Reuse the vertices, indices and draw commands a scope submitted on an earlier frame while 'hash' is unchanged, skipping its layout and tessellation.
+    //   The scope only runs when BeginCachedDraw() returns true, in which case call EndCachedDraw() at the end of it.
+    // - 'hash' must cover everything the scope draws (text, colors, textures, style...). The cursor position, current font, work rect and clip rect are hashed for you.
+    // - Only for non-interactive items: Text(), Image(), Separator(), custom drawing... Items inside are not submitted on frames where the scope is skipped,
+    //   so they can't be hovered or clicked and IsItemXXX() functions after EndCachedDraw() don't refer to them. Keep interactive widgets out of the scope.
+    // - Wrap a whole window's contents to cache it, only the window decorations are then rebuilt.
+    //   e.g. static ImGuiDrawCache cache; if (ImGui::BeginCachedDraw(&cache, ImGui::GetID(legend_text))) { ImGui::TextUnformatted(legend_text); ImGui::EndCachedDraw(&cache); }
+    IMGUI_API bool          BeginCachedDraw(ImGuiDrawCache* cache, ImU32 hash);
+    IMGUI_API void          EndCachedDraw(ImGuiDrawCache* cache);
+
     // Focus, Activation
     IMGUI_API void          SetItemDefaultFocus();                                              // make last item the default focused item of a newly appearing window.
     IMGUI_API void          SetKeyboardFocusHere(int offset = 0);                               // focus keyboard on the next widget. Use positive 'offset' to access sub components of a multiple component widget. Use -1 to access previous widget.
@@ -2947,7 +2962,7 @@ struct ImGuiSelectionExternalStorage
 };
 
 //-----------------------------------------------------------------------------
-// [SECTION] Drawing API (ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawListFlags, ImDrawList, ImDrawData)
+// [SECTION] Drawing API (ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawListCache, ImDrawListFlags, ImDrawList, ImDrawData)
 // Hold a series of drawing commands. The user provides a renderer for ImDrawData which essentially contains an array of ImDrawList.
 //-----------------------------------------------------------------------------
 
@@ -3044,6 +3059,91 @@ struct ImDrawListSplitter
     IMGUI_API void              SetCurrentChannel(ImDrawList* draw_list, int channel_idx);
 };
 
+// Geometry a scope of a draw list submitted on an earlier frame, replayed instead of rebuilt while the scope's hash is unchanged.
+// - Keep one instance per scope alive across frames. See ImDrawList::BeginCachedSegment() and ImGui::BeginCachedDraw().
+// - Indices are stored as they were submitted, and only need rebasing when the scope starts at a different vertex index than when recorded.
+struct ImDrawListCache
+{
+    ImU32                       _Hash;              // Hash the cached geometry was recorded with
+    bool                        _Valid;             // Geometry was fully recorded and can be replayed
+    unsigned int                _VtxBase;           // _VtxCurrentIdx the cached indices are relative to
+    ImVector<ImDrawVert>        _VtxBuffer;
+    ImVector<ImDrawIdx>         _IdxBuffer;
+    ImVector<ImDrawCmd>         _CmdBuffer;         // ClipRect, TextureId and ElemCount of each run of indices sharing them
+    int                         _RecCmdCount;       // [Recording] CmdBuffer.Size when the scope started
+    int                         _RecVtxStart;       // [Recording] VtxBuffer.Size when the scope started
+    int                         _RecIdxStart;       // [Recording] IdxBuffer.Size when the scope started
+    unsigned int                _RecVtxOffset;      // [Recording] _CmdHeader.VtxOffset when the scope started
+    int                         _RecClipRectStackSize;
+    int                         _RecTextureIdStackSize;
+
+    inline ImDrawListCache()    { _Hash = 0; _Valid = false; _VtxBase = 0; _RecCmdCount = _RecVtxStart = _RecIdxStart = 0; _RecVtxOffset = 0; _RecClipRectStackSize = _RecTextureIdStackSize = 0; }
+    inline void                 Clear() { _Valid = false; } // Force the scope to be submitted again. Buffers are kept so they are reused when recording
+    inline void                 ClearFreeMemory() { Clear(); _VtxBuffer.clear(); _IdxBuffer.clear(); _CmdBuffer.clear(); }
+};
+
+// Geometry and layout of a scope of non-interactive items, replayed instead of resubmitted while the scope's hash is unchanged. See ImGui::BeginCachedDraw().
+struct ImGuiDrawCache
+{
+    ImDrawListCache             DrawCache;
+    ImVec2                      _CursorPos;         // Layout at the end of the scope
+    ImVec2                      _CursorPosPrevLine;
+    ImVec2                      _CursorMaxPos;      // Extent of the items in the scope alone
+    ImVec2                      _CurrLineSize;
+    ImVec2                      _PrevLineSize;
+    float                       _CurrLineTextBaseOffset;
+    float                       _PrevLineTextBaseOffset;
+    bool                        _IsSameLine;
+    bool                        _IsSetPos;
+    ImVec2                      _RecCursorMaxPos;   // [Recording] Window's CursorMaxPos when the scope started
+
+    inline ImGuiDrawCache()     { _CurrLineTextBaseOffset = _PrevLineTextBaseOffset = 0.0f; _IsSameLine = _IsSetPos = false; }
+    inline void                 Clear() { DrawCache.Clear(); }
+};
+
+// Helper to build draw lists on worker threads, then append them in a defined order. [BETA API]
+// - Begin() on the main thread, between NewFrame() and Render(), hands out 'count' lists that draw like 'parent' at the time of the call:
+//   same font atlas, ClipRect, TextureId and flags. Each list gets its own copy of the shared data, as its scratch buffers can't be shared.
+// - Fill GetDrawList(n) from any thread, one thread per list. Only use ImDrawList functions there, not ImGui:: ones.
+// - End() on the main thread once all workers are done. Then either MergeInto() a draw list (e.g. ImGui::GetWindowDrawList()) to
+//   draw in order with it, or AddToDrawData() after ImGui::Render() to draw the lists over everything else, in order.
+// - Allocations go through IM_ALLOC()/IM_FREE(): a custom allocator set with SetAllocatorFunctions() needs to be thread-safe.
+// - Lists are owned by this helper and reused next frame: keep it alive until the frame is rendered.
+struct ImDrawListParallel
+{
+    int                             _Count;         // Number of lists handed out by Begin()
+    bool                            _Building;      // Between Begin() and End()
+    ImGuiContext*                   _Context;       // Context whose allocation hooks are suspended between Begin() and End()
+    ImVector<ImDrawList*>           _Lists;         // Not resized down so _Count might be < _Lists.Size
+    ImVector<ImDrawListSharedData*> _SharedData;    // One copy of the parent's shared data per list
+
+    inline ImDrawListParallel()  { memset(this, 0, sizeof(*this)); }
+    inline ~ImDrawListParallel() { ClearFreeMemory(); }
+    IMGUI_API void              ClearFreeMemory();
+    IMGUI_API void              Begin(ImDrawList* parent, int count);
+    IMGUI_API void              End();
+    IMGUI_API void              MergeInto(ImDrawList* draw_list);
+    IMGUI_API void              AddToDrawData(ImDrawData* draw_data);
+    inline ImDrawList*          GetDrawList(int n) const { IM_ASSERT(_Building && n >= 0 && n < _Count); return _Lists.Data[n]; }
+};
+
+// Filled shape tessellated once, then stamped out many times by ImDrawList::AddShapeInstances().
+// - Build it with the draw list it will be drawn into, whose anti-aliasing flags and tessellation settings it uses. Coordinates are relative to the instance center.
+// - Positions are scaled by the instance size, while the anti-aliased fringe is kept apart so it stays the same width in pixels.
+// - Circle tessellation is picked for the radius it is built with: build one shape per size class if sizes vary a lot.
+struct ImDrawInstanceShape
+{
+    ImVector<ImVec2>            _Pos;               // Vertex position at size 1.0f
+    ImVector<ImVec2>            _Offset;            // Vertex offset not scaled by size (anti-aliased fringe)
+    ImVector<ImU32>             _ColMask;           // Applied to the instance color, clears the alpha of the fringe's outer edge
+    ImVector<ImDrawIdx>         _IdxBuffer;         // Indices relative to the instance's first vertex
+
+    inline void                 Clear() { _Pos.resize(0); _Offset.resize(0); _ColMask.resize(0); _IdxBuffer.resize(0); }
+    IMGUI_API void              BuildConvexPolyFilled(const ImDrawList* draw_list, const ImVec2* points, int num_points);
+    IMGUI_API void              BuildCircleFilled(ImDrawList* draw_list, float radius, int num_segments = 0);
+    IMGUI_API void              BuildRectFilled(ImDrawList* draw_list, const ImVec2& p_min, const ImVec2& p_max, float rounding = 0.0f, ImDrawFlags flags = 0);
+};
+
 // Flags for ImDrawList functions
 // (Legacy: bit 0 must always correspond to ImDrawFlags_Closed to be backward compatible with old API using a bool. Bits 1..3 must be unused)
 enum ImDrawFlags_
@@ -3152,6 +3252,14 @@ struct ImDrawList
     IMGUI_API void  AddConvexPolyFilled(const ImVec2* points, int num_points, ImU32 col);
     IMGUI_API void  AddConcavePolyFilled(const ImVec2* points, int num_points, ImU32 col);
 
+    // Instanced shapes
+    // - Draw 'count' copies of a shape built once with ImDrawInstanceShape::BuildXXX(), each scaled by sizes[i], centered on centers[i] and tinted with colors[i].
+    //   'sizes' may be NULL to draw every instance as built. Instances with a fully transparent color are skipped.
+    // - Geometry for all instances is reserved in one go. With 16-bit indices, instances are written in batches of less than 64K vertices,
+    //   which needs ImGuiBackendFlags_RendererHasVtxOffset past 64K vertices in a draw list, as with any other primitive.
+    // - No clipping is done: leave out instances outside the clip rect yourself.
+    IMGUI_API void  AddShapeInstances(const ImDrawInstanceShape* shape, const ImVec2* centers, const float* sizes, const ImU32* colors, int count);
+
     // Image primitives
     // - Read FAQ to understand what ImTextureID is.
     // - "p_min" and "p_max" represent the upper-left and lower-right corners of the rectangle.
@@ -3191,6 +3299,16 @@ struct ImDrawList
     IMGUI_API void  AddDrawCmd();                                               // This is useful if you need to forcefully create a new draw call (to allow for dependent rendering / blending). Otherwise primitives are merged into the same draw-call as much as possible
     IMGUI_API ImDrawList* CloneOutput() const;                                  // Create a clone of the CmdBuffer/IdxBuffer/VtxBuffer.
 
+    // Advanced: Retained segments
+    // - Replay the geometry a scope submitted on an earlier frame while its hash is unchanged, instead of tessellating it again.
+    //   Vertices are copied as-is, so 'hash' must cover everything the scope draws, including positions. The clip rect, texture and anti-aliasing settings are hashed for you.
+    // - Usage: 'if (draw_list->BeginCachedSegment(&cache, hash)) { ...draw...; draw_list->EndCachedSegment(&cache); }'
+    //   BeginCachedSegment() returns false after appending the cached geometry, in which case the scope must be skipped.
+    // - Pushes and pops must be balanced within the scope, and it must not switch channels. Scopes with callbacks are submitted every frame.
+    // - To skip the layout of ImGui items along with their geometry, use ImGui::BeginCachedDraw().
+    IMGUI_API bool  BeginCachedSegment(ImDrawListCache* cache, ImU32 hash);
+    IMGUI_API void  EndCachedSegment(ImDrawListCache* cache);
+
     // Advanced: Channels
     // - Use to split render into layers. By switching channels to can render out-of-order (e.g. submit FG primitives before BG primitives)
     // - Use to minimize draw calls (e.g. if going back-and-forth between multiple clipping rectangles, prefer to append into separate channels then merge at the end)
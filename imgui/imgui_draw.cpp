@@ -10,6 +10,8 @@ Index of this file:
 // [SECTION] ImDrawList
 // [SECTION] ImTriangulator, ImDrawList concave polygon fill
 // [SECTION] ImDrawListSplitter
+// [SECTION] ImDrawList retained segments (ImDrawListCache)
+// [SECTION] ImDrawListParallel
 // [SECTION] ImDrawData
 // [SECTION] Helpers ShadeVertsXXX functions
 // [SECTION] ImFontConfig
@@ -759,6 +761,297 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_FIXNORMAL2F_MAX_INVLEN2          100.0f // 500.0f (see #4053, #3366)
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > IM_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = IM_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } (void)0
 
+// Bulk versions of the above for AddPolyline() and AddConvexPolyFilled(), using SSE (2 points at a time), AVX (4 points) or AArch64 NEON (2 points) when available (see IMGUI_ENABLE_SIMD_DRAWLIST_XXX).
+// - Points and normals are read as interleaved x,y pairs, so one register holds whole points and no shuffling into separate x/y arrays is needed.
+// - Operations are the same and in the same order as the macros, so results match the scalar loops. With IMGUI_ENABLE_SSE, ImRsqrt() is the
+//   RSQRTSS approximation, which RSQRTPS reproduces on a given CPU. NEON computes 1/sqrt like the non-SSE ImRsqrt().
+// - A scalar tail handles what doesn't fill a register.
+#if defined(IMGUI_ENABLE_SIMD_DRAWLIST_SSE)
+static inline __m128 ImSimdSwapXY(__m128 v)                             { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); }
+static inline __m128 ImSimdSelect(__m128 mask, __m128 a, __m128 b)     { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); } // mask ? a : b
+#endif
+
+// out_normals[i] = unit normal of segment points[i] -> points[i + 1], for i in [0, count). Reads points[0..count].
+static void ImPolylineComputeNormals(const ImVec2* points, int count, ImVec2* out_normals)
+{
+    int i = 0;
+#if defined(IMGUI_ENABLE_SIMD_DRAWLIST_AVX)
+    {
+        const __m256 sign = _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f, 0.0f, -0.0f);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 zero = _mm256_setzero_ps();
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256 d = _mm256_sub_ps(_mm256_loadu_ps(&points[i + 1].x), _mm256_loadu_ps(&points[i].x));
+            __m256 sq = _mm256_mul_ps(d, d);
+            __m256 d2 = _mm256_add_ps(sq, _mm256_permute_ps(sq, _MM_SHUFFLE(2, 3, 0, 1)));
+            __m256 inv_len = _mm256_blendv_ps(one, _mm256_rsqrt_ps(d2), _mm256_cmp_ps(d2, zero, _CMP_GT_OQ));
+            d = _mm256_mul_ps(d, inv_len);
+            _mm256_storeu_ps(&out_normals[i].x, _mm256_xor_ps(_mm256_permute_ps(d, _MM_SHUFFLE(2, 3, 0, 1)), sign)); // (dy, -dx)
+        }
+    }
+#endif
+#if defined(IMGUI_ENABLE_SIMD_DRAWLIST_SSE)
+    {
+        const __m128 sign = _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 zero = _mm_setzero_ps();
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128 d = _mm_sub_ps(_mm_loadu_ps(&points[i + 1].x), _mm_loadu_ps(&points[i].x));
+            __m128 sq = _mm_mul_ps(d, d);
+            __m128 d2 = _mm_add_ps(sq, ImSimdSwapXY(sq));
+            __m128 inv_len = ImSimdSelect(_mm_cmpgt_ps(d2, zero), _mm_rsqrt_ps(d2), one);
+            d = _mm_mul_ps(d, inv_len);
+            _mm_storeu_ps(&out_normals[i].x, _mm_xor_ps(ImSimdSwapXY(d), sign)); // (dy, -dx)
+        }
+    }
+#elif defined(IMGUI_ENABLE_SIMD_DRAWLIST_NEON)
+    {
+        const float sign_values[4] = { 1.0f, -1.0f, 1.0f, -1.0f };
+        const float32x4_t sign = vld1q_f32(sign_values);
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        for (; i + 2 <= count; i += 2)
+        {
+            float32x4_t d = vsubq_f32(vld1q_f32(&points[i + 1].x), vld1q_f32(&points[i].x));
+            float32x4_t sq = vmulq_f32(d, d);
+            float32x4_t d2 = vaddq_f32(sq, vrev64q_f32(sq));
+            float32x4_t inv_len = vbslq_f32(vcgtq_f32(d2, zero), vdivq_f32(one, vsqrtq_f32(d2)), one);
+            d = vmulq_f32(d, inv_len);
+            vst1q_f32(&out_normals[i].x, vmulq_f32(vrev64q_f32(d), sign)); // (dy, -dx)
+        }
+    }
+#endif
+    for (; i < count; i++)
+    {
+        float dx = points[i + 1].x - points[i].x;
+        float dy = points[i + 1].y - points[i].y;
+        IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+        out_normals[i].x = dy;
+        out_normals[i].y = -dx;
+    }
+}
+
+// out_miters[i] = IM_FIXNORMAL2F() of the average of normals[i] and normals[i + 1], for i in [0, count). Reads normals[0..count].
+static void ImPolylineComputeMiters(const ImVec2* normals, int count, ImVec2* out_miters)
+{
+    int i = 0;
+#if defined(IMGUI_ENABLE_SIMD_DRAWLIST_AVX)
+    {
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 min_d2 = _mm256_set1_ps(0.000001f);
+        const __m256 max_inv_len2 = _mm256_set1_ps(IM_FIXNORMAL2F_MAX_INVLEN2);
+        for (; i + 4 <= count; i += 4)
+        {
+            __m256 dm = _mm256_mul_ps(_mm256_add_ps(_mm256_loadu_ps(&normals[i].x), _mm256_loadu_ps(&normals[i + 1].x)), half);
+            __m256 sq = _mm256_mul_ps(dm, dm);
+            __m256 d2 = _mm256_add_ps(sq, _mm256_permute_ps(sq, _MM_SHUFFLE(2, 3, 0, 1)));
+            __m256 inv_len2 = _mm256_min_ps(_mm256_div_ps(one, d2), max_inv_len2);
+            dm = _mm256_blendv_ps(dm, _mm256_mul_ps(dm, inv_len2), _mm256_cmp_ps(d2, min_d2, _CMP_GT_OQ));
+            _mm256_storeu_ps(&out_miters[i].x, dm);
+        }
+    }
+#endif
+#if defined(IMGUI_ENABLE_SIMD_DRAWLIST_SSE)
+    {
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 min_d2 = _mm_set1_ps(0.000001f);
+        const __m128 max_inv_len2 = _mm_set1_ps(IM_FIXNORMAL2F_MAX_INVLEN2);
+        for (; i + 2 <= count; i += 2)
+        {
+            __m128 dm = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&normals[i].x), _mm_loadu_ps(&normals[i + 1].x)), half);
+            __m128 sq = _mm_mul_ps(dm, dm);
+            __m128 d2 = _mm_add_ps(sq, ImSimdSwapXY(sq));
+            __m128 inv_len2 = _mm_min_ps(_mm_div_ps(one, d2), max_inv_len2);
+            dm = ImSimdSelect(_mm_cmpgt_ps(d2, min_d2), _mm_mul_ps(dm, inv_len2), dm);
+            _mm_storeu_ps(&out_miters[i].x, dm);
+        }
+    }
+#elif defined(IMGUI_ENABLE_SIMD_DRAWLIST_NEON)
+    {
+        const float32x4_t half = vdupq_n_f32(0.5f);
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        const float32x4_t min_d2 = vdupq_n_f32(0.000001f);
+        const float32x4_t max_inv_len2 = vdupq_n_f32(IM_FIXNORMAL2F_MAX_INVLEN2);
+        for (; i + 2 <= count; i += 2)
+        {
+            float32x4_t dm = vmulq_f32(vaddq_f32(vld1q_f32(&normals[i].x), vld1q_f32(&normals[i + 1].x)), half);
+            float32x4_t sq = vmulq_f32(dm, dm);
+            float32x4_t d2 = vaddq_f32(sq, vrev64q_f32(sq));
+            float32x4_t inv_len2 = vminq_f32(vdivq_f32(one, d2), max_inv_len2);
+            dm = vbslq_f32(vcgtq_f32(d2, min_d2), vmulq_f32(dm, inv_len2), dm);
+            vst1q_f32(&out_miters[i].x, dm);
+        }
+    }
+#endif
+    for (; i < count; i++)
+    {
+        float dm_x = (normals[i].x + normals[i + 1].x) * 0.5f;
+        float dm_y = (normals[i].y + normals[i + 1].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        out_miters[i].x = dm_x;
+        out_miters[i].y = dm_y;
+    }
+}
+
+// Write 'verts_per_point' vertices for each point: vtx[i * verts_per_point + k] = { points[i] + miters[i] * offsets[k], uvs[k], cols[k] }.
+// With the default ImDrawVert layout, position and uv go out as one 16 bytes store.
+static void ImPolylineWriteVerts(ImDrawVert* vtx, const ImVec2* points, const ImVec2* miters, int points_count, const float* offsets, const ImVec2* uvs, const ImU32* cols, int verts_per_point)
+{
+    IM_ASSERT(verts_per_point <= 4);
+    int i = 0;
+#if !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT) && defined(IMGUI_ENABLE_SIMD_DRAWLIST_SSE)
+    __m128 offsets_4[4], uvs_4[4];
+    for (int k = 0; k < verts_per_point; k++)
+    {
+        offsets_4[k] = _mm_set1_ps(offsets[k]);
+        uvs_4[k] = _mm_setr_ps(uvs[k].x, uvs[k].y, uvs[k].x, uvs[k].y);
+    }
+    for (; i + 2 <= points_count; i += 2, vtx += verts_per_point * 2)
+    {
+        const __m128 p = _mm_loadu_ps(&points[i].x);
+        const __m128 dm = _mm_loadu_ps(&miters[i].x);
+        for (int k = 0; k < verts_per_point; k++)
+        {
+            const __m128 pos = _mm_add_ps(p, _mm_mul_ps(dm, offsets_4[k]));
+            _mm_storeu_ps(&vtx[k].pos.x, _mm_movelh_ps(pos, uvs_4[k]));                    // pos.x, pos.y, uv.x, uv.y of point i
+            _mm_storeu_ps(&vtx[verts_per_point + k].pos.x, _mm_movehl_ps(uvs_4[k], pos));  // same for point i + 1
+            vtx[k].col = vtx[verts_per_point + k].col = cols[k];
+        }
+    }
+#elif !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT) && defined(IMGUI_ENABLE_SIMD_DRAWLIST_NEON)
+    for (; i + 2 <= points_count; i += 2, vtx += verts_per_point * 2)
+    {
+        const float32x4_t p = vld1q_f32(&points[i].x);
+        const float32x4_t dm = vld1q_f32(&miters[i].x);
+        for (int k = 0; k < verts_per_point; k++)
+        {
+            const float32x4_t pos = vaddq_f32(p, vmulq_f32(dm, vdupq_n_f32(offsets[k])));
+            const float32x2_t uv = vld1_f32(&uvs[k].x);
+            vst1q_f32(&vtx[k].pos.x, vcombine_f32(vget_low_f32(pos), uv));
+            vst1q_f32(&vtx[verts_per_point + k].pos.x, vcombine_f32(vget_high_f32(pos), uv));
+            vtx[k].col = vtx[verts_per_point + k].col = cols[k];
+        }
+    }
+#endif
+    for (; i < points_count; i++, vtx += verts_per_point)
+        for (int k = 0; k < verts_per_point; k++)
+        {
+            vtx[k].pos.x = points[i].x + miters[i].x * offsets[k];
+            vtx[k].pos.y = points[i].y + miters[i].y * offsets[k];
+            vtx[k].uv = uvs[k];
+            vtx[k].col = cols[k];
+        }
+}
+
+// Write the inner and outer fringe vertices of AddConvexPolyFilled(): vtx[i * 2 + 0/1] = { points[i] -/+ miter * half_fringe, uv, col/col_trans },
+// where miter is IM_FIXNORMAL2F() of the average of normals[i] and normals[i + 1], for i in [0, count). Reads normals[0..count].
+static void ImConvexFillWriteVerts(ImDrawVert* vtx, const ImVec2* points, const ImVec2* normals, int count, float half_fringe, const ImVec2& uv, ImU32 col, ImU32 col_trans)
+{
+    int i = 0;
+#if !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT) && defined(IMGUI_ENABLE_SIMD_DRAWLIST_SSE)
+    {
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 min_d2 = _mm_set1_ps(0.000001f);
+        const __m128 max_inv_len2 = _mm_set1_ps(IM_FIXNORMAL2F_MAX_INVLEN2);
+        const __m128 fringe = _mm_set1_ps(half_fringe);
+        const __m128 uv_2 = _mm_setr_ps(uv.x, uv.y, uv.x, uv.y);
+        for (; i + 2 <= count; i += 2, vtx += 4)
+        {
+            __m128 dm = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(&normals[i].x), _mm_loadu_ps(&normals[i + 1].x)), half);
+            __m128 sq = _mm_mul_ps(dm, dm);
+            __m128 d2 = _mm_add_ps(sq, ImSimdSwapXY(sq));
+            __m128 inv_len2 = _mm_min_ps(_mm_div_ps(one, d2), max_inv_len2);
+            dm = ImSimdSelect(_mm_cmpgt_ps(d2, min_d2), _mm_mul_ps(dm, inv_len2), dm);
+            dm = _mm_mul_ps(dm, fringe);
+            const __m128 p = _mm_loadu_ps(&points[i].x);
+            const __m128 inner = _mm_sub_ps(p, dm);
+            const __m128 outer = _mm_add_ps(p, dm);
+            _mm_storeu_ps(&vtx[0].pos.x, _mm_movelh_ps(inner, uv_2));
+            _mm_storeu_ps(&vtx[1].pos.x, _mm_movelh_ps(outer, uv_2));
+            _mm_storeu_ps(&vtx[2].pos.x, _mm_movehl_ps(uv_2, inner));
+            _mm_storeu_ps(&vtx[3].pos.x, _mm_movehl_ps(uv_2, outer));
+            vtx[0].col = vtx[2].col = col;
+            vtx[1].col = vtx[3].col = col_trans;
+        }
+    }
+#elif !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT) && defined(IMGUI_ENABLE_SIMD_DRAWLIST_NEON)
+    {
+        const float32x4_t half = vdupq_n_f32(0.5f);
+        const float32x4_t one = vdupq_n_f32(1.0f);
+        const float32x4_t min_d2 = vdupq_n_f32(0.000001f);
+        const float32x4_t max_inv_len2 = vdupq_n_f32(IM_FIXNORMAL2F_MAX_INVLEN2);
+        const float32x2_t uv_1 = vld1_f32(&uv.x);
+        for (; i + 2 <= count; i += 2, vtx += 4)
+        {
+            float32x4_t dm = vmulq_f32(vaddq_f32(vld1q_f32(&normals[i].x), vld1q_f32(&normals[i + 1].x)), half);
+            float32x4_t sq = vmulq_f32(dm, dm);
+            float32x4_t d2 = vaddq_f32(sq, vrev64q_f32(sq));
+            float32x4_t inv_len2 = vminq_f32(vdivq_f32(one, d2), max_inv_len2);
+            dm = vbslq_f32(vcgtq_f32(d2, min_d2), vmulq_f32(dm, inv_len2), dm);
+            dm = vmulq_n_f32(dm, half_fringe);
+            const float32x4_t p = vld1q_f32(&points[i].x);
+            const float32x4_t inner = vsubq_f32(p, dm);
+            const float32x4_t outer = vaddq_f32(p, dm);
+            vst1q_f32(&vtx[0].pos.x, vcombine_f32(vget_low_f32(inner), uv_1));
+            vst1q_f32(&vtx[1].pos.x, vcombine_f32(vget_low_f32(outer), uv_1));
+            vst1q_f32(&vtx[2].pos.x, vcombine_f32(vget_high_f32(inner), uv_1));
+            vst1q_f32(&vtx[3].pos.x, vcombine_f32(vget_high_f32(outer), uv_1));
+            vtx[0].col = vtx[2].col = col;
+            vtx[1].col = vtx[3].col = col_trans;
+        }
+    }
+#endif
+    for (; i < count; i++, vtx += 2)
+    {
+        float dm_x = (normals[i].x + normals[i + 1].x) * 0.5f;
+        float dm_y = (normals[i].y + normals[i + 1].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        dm_x *= half_fringe;
+        dm_y *= half_fringe;
+        vtx[0].pos.x = (points[i].x - dm_x); vtx[0].pos.y = (points[i].y - dm_y); vtx[0].uv = uv; vtx[0].col = col;
+        vtx[1].pos.x = (points[i].x + dm_x); vtx[1].pos.y = (points[i].y + dm_y); vtx[1].uv = uv; vtx[1].col = col_trans;
+    }
+}
+
+// points[i] = center + points[i] * radius, for i in [0, count). Used by _PathArcToFastEx() to place unit circle samples.
+static void ImScalePoints(ImVec2* points, int count, const ImVec2& center, float radius)
+{
+    int i = 0;
+#if defined(IMGUI_ENABLE_SIMD_DRAWLIST_AVX)
+    {
+        const __m256 c = _mm256_setr_ps(center.x, center.y, center.x, center.y, center.x, center.y, center.x, center.y);
+        const __m256 r = _mm256_set1_ps(radius);
+        for (; i + 4 <= count; i += 4)
+            _mm256_storeu_ps(&points[i].x, _mm256_add_ps(c, _mm256_mul_ps(_mm256_loadu_ps(&points[i].x), r)));
+    }
+#endif
+#if defined(IMGUI_ENABLE_SIMD_DRAWLIST_SSE)
+    {
+        const __m128 c = _mm_setr_ps(center.x, center.y, center.x, center.y);
+        const __m128 r = _mm_set1_ps(radius);
+        for (; i + 2 <= count; i += 2)
+            _mm_storeu_ps(&points[i].x, _mm_add_ps(c, _mm_mul_ps(_mm_loadu_ps(&points[i].x), r)));
+    }
+#elif defined(IMGUI_ENABLE_SIMD_DRAWLIST_NEON)
+    {
+        const float c_values[4] = { center.x, center.y, center.x, center.y };
+        const float32x4_t c = vld1q_f32(c_values);
+        for (; i + 2 <= count; i += 2)
+            vst1q_f32(&points[i].x, vaddq_f32(c, vmulq_n_f32(vld1q_f32(&points[i].x), radius)));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        points[i].x = center.x + points[i].x * radius;
+        points[i].y = center.y + points[i].y * radius;
+    }
+}
+
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
@@ -795,24 +1088,38 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         PrimReserve(idx_count, vtx_count);
 
         // Temporary buffer
-        // The first <points_count> items are normals at each line point, then after that there are either 2 or 4 temp points for each line point
-        _Data->TempBuffer.reserve_discard(points_count * ((use_texture || !thick_line) ? 3 : 5));
+        // The first <points_count> items are normals of each line segment, then the offset direction at each line point (normals of both adjoining segments averaged)
+        _Data->TempBuffer.reserve_discard(points_count * 2);
         ImVec2* temp_normals = _Data->TempBuffer.Data;
-        ImVec2* temp_points = temp_normals + points_count;
+        ImVec2* temp_miters = temp_normals + points_count;
 
-        // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
+        // Calculate normals (tangents) for each line segment, the closing segment of a closed line wraps around to the first point
+        ImPolylineComputeNormals(points, points_count - 1, temp_normals);
+        if (closed)
         {
-            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
-            float dx = points[i2].x - points[i1].x;
-            float dy = points[i2].y - points[i1].y;
+            float dx = points[0].x - points[points_count - 1].x;
+            float dy = points[0].y - points[points_count - 1].y;
             IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i1].x = dy;
-            temp_normals[i1].y = -dx;
+            temp_normals[points_count - 1].x = dy;
+            temp_normals[points_count - 1].y = -dx;
         }
-        if (!closed)
+        else
             temp_normals[points_count - 1] = temp_normals[points_count - 2];
 
+        // Average normals at each point. This takes segments n and n+1 and writes into point n+1, with the first point in a closed line
+        // being generated from the final segment. If line is not closed, the first point has no normals to blend.
+        ImPolylineComputeMiters(temp_normals, points_count - 1, temp_miters + 1);
+        if (closed)
+        {
+            float dm_x = (temp_normals[points_count - 1].x + temp_normals[0].x) * 0.5f;
+            float dm_y = (temp_normals[points_count - 1].y + temp_normals[0].y) * 0.5f;
+            IM_FIXNORMAL2F(dm_x, dm_y);
+            temp_miters[0].x = dm_x;
+            temp_miters[0].y = dm_y;
+        }
+        else
+            temp_miters[0] = temp_normals[0];
+
         // If we are drawing a one-pixel-wide line without a texture, or a textured line of any width, we only need 2 or 3 vertices per point
         if (use_texture || !thick_line)
         {
@@ -826,38 +1133,11 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             //   allow scaling geometry while preserving one-screen-pixel AA fringe).
             const float half_draw_size = use_texture ? ((thickness * 0.5f) + 1) : AA_SIZE;
 
-            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
-            if (!closed)
-            {
-                temp_points[0] = points[0] + temp_normals[0] * half_draw_size;
-                temp_points[1] = points[0] - temp_normals[0] * half_draw_size;
-                temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * half_draw_size;
-                temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * half_draw_size;
-            }
-
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+            // Generate the indices to form a number of triangles for each line segment
             unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
             for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
             {
-                const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
                 const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
-
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
-                dm_y *= half_draw_size;
-
-                // Add temporary vertexes for the outer edges
-                ImVec2* out_vtx = &temp_points[i2 * 2];
-                out_vtx[0].x = points[i2].x + dm_x;
-                out_vtx[0].y = points[i2].y + dm_y;
-                out_vtx[1].x = points[i2].x - dm_x;
-                out_vtx[1].y = points[i2].y - dm_y;
-
                 if (use_texture)
                 {
                     // Add indices for two triangles
@@ -878,7 +1158,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 idx1 = idx2;
             }
 
-            // Add vertexes for each point on the line
+            // Add vertexes for each point on the line, offset to the outer edges of the AA area
             if (use_texture)
             {
                 // If we're using textures we only need to emit the left/right edge vertices
@@ -891,25 +1171,18 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                     tex_uvs.z = tex_uvs.z + (tex_uvs_1.z - tex_uvs.z) * fractional_thickness;
                     tex_uvs.w = tex_uvs.w + (tex_uvs_1.w - tex_uvs.w) * fractional_thickness;
                 }*/
-                ImVec2 tex_uv0(tex_uvs.x, tex_uvs.y);
-                ImVec2 tex_uv1(tex_uvs.z, tex_uvs.w);
-                for (int i = 0; i < points_count; i++)
-                {
-                    _VtxWritePtr[0].pos = temp_points[i * 2 + 0]; _VtxWritePtr[0].uv = tex_uv0; _VtxWritePtr[0].col = col; // Left-side outer edge
-                    _VtxWritePtr[1].pos = temp_points[i * 2 + 1]; _VtxWritePtr[1].uv = tex_uv1; _VtxWritePtr[1].col = col; // Right-side outer edge
-                    _VtxWritePtr += 2;
-                }
+                const float offsets[2] = { half_draw_size, -half_draw_size };                   // Left-side outer edge, right-side outer edge
+                const ImVec2 uvs[2] = { ImVec2(tex_uvs.x, tex_uvs.y), ImVec2(tex_uvs.z, tex_uvs.w) };
+                const ImU32 cols[2] = { col, col };
+                ImPolylineWriteVerts(_VtxWritePtr, points, temp_miters, points_count, offsets, uvs, cols, 2);
             }
             else
             {
                 // If we're not using a texture, we need the center vertex as well
-                for (int i = 0; i < points_count; i++)
-                {
-                    _VtxWritePtr[0].pos = points[i];              _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;       // Center of line
-                    _VtxWritePtr[1].pos = temp_points[i * 2 + 0]; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col_trans; // Left-side outer edge
-                    _VtxWritePtr[2].pos = temp_points[i * 2 + 1]; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col_trans; // Right-side outer edge
-                    _VtxWritePtr += 3;
-                }
+                const float offsets[3] = { 0.0f, half_draw_size, -half_draw_size };             // Center of line, left-side outer edge, right-side outer edge
+                const ImVec2 uvs[3] = { opaque_uv, opaque_uv, opaque_uv };
+                const ImU32 cols[3] = { col, col_trans, col_trans };
+                ImPolylineWriteVerts(_VtxWritePtr, points, temp_miters, points_count, offsets, uvs, cols, 3);
             }
         }
         else
@@ -917,49 +1190,12 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             // [PATH 2] Non texture-based lines (thick): we need to draw the solid line core and thus require four vertices per point
             const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
 
-            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
-            if (!closed)
-            {
-                const int points_last = points_count - 1;
-                temp_points[0] = points[0] + temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[1] = points[0] + temp_normals[0] * (half_inner_thickness);
-                temp_points[2] = points[0] - temp_normals[0] * (half_inner_thickness);
-                temp_points[3] = points[0] - temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[points_last * 4 + 0] = points[points_last] + temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
-                temp_points[points_last * 4 + 1] = points[points_last] + temp_normals[points_last] * (half_inner_thickness);
-                temp_points[points_last * 4 + 2] = points[points_last] - temp_normals[points_last] * (half_inner_thickness);
-                temp_points[points_last * 4 + 3] = points[points_last] - temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
-            }
-
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+            // Generate the indices to form a number of triangles for each line segment
             unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
             for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
             {
-                const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
                 const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
 
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
-                float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
-                float dm_in_x = dm_x * half_inner_thickness;
-                float dm_in_y = dm_y * half_inner_thickness;
-
-                // Add temporary vertices
-                ImVec2* out_vtx = &temp_points[i2 * 4];
-                out_vtx[0].x = points[i2].x + dm_out_x;
-                out_vtx[0].y = points[i2].y + dm_out_y;
-                out_vtx[1].x = points[i2].x + dm_in_x;
-                out_vtx[1].y = points[i2].y + dm_in_y;
-                out_vtx[2].x = points[i2].x - dm_in_x;
-                out_vtx[2].y = points[i2].y - dm_in_y;
-                out_vtx[3].x = points[i2].x - dm_out_x;
-                out_vtx[3].y = points[i2].y - dm_out_y;
-
                 // Add indexes
                 _IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
                 _IdxWritePtr[3]  = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2 + 1);
@@ -972,16 +1208,13 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 idx1 = idx2;
             }
 
-            // Add vertices
-            for (int i = 0; i < points_count; i++)
-            {
-                _VtxWritePtr[0].pos = temp_points[i * 4 + 0]; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col_trans;
-                _VtxWritePtr[1].pos = temp_points[i * 4 + 1]; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
-                _VtxWritePtr[2].pos = temp_points[i * 4 + 2]; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
-                _VtxWritePtr[3].pos = temp_points[i * 4 + 3]; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col_trans;
-                _VtxWritePtr += 4;
-            }
+            // Add vertices, from the outer edge of the AA area on one side to the outer edge on the other
+            const float offsets[4] = { half_inner_thickness + AA_SIZE, half_inner_thickness, -half_inner_thickness, -(half_inner_thickness + AA_SIZE) };
+            const ImVec2 uvs[4] = { opaque_uv, opaque_uv, opaque_uv, opaque_uv };
+            const ImU32 cols[4] = { col_trans, col, col, col_trans };
+            ImPolylineWriteVerts(_VtxWritePtr, points, temp_miters, points_count, offsets, uvs, cols, 4);
         }
+        _VtxWritePtr += vtx_count;
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
     else
@@ -1044,39 +1277,34 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             _IdxWritePtr += 3;
         }
 
-        // Compute normals
-        _Data->TempBuffer.reserve_discard(points_count);
+        // Compute normals, temp_normals[i] is the normal of the edge ending at point i, so the closing edge comes first
+        _Data->TempBuffer.reserve_discard(points_count + 1);
         ImVec2* temp_normals = _Data->TempBuffer.Data;
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        ImPolylineComputeNormals(points, points_count - 1, temp_normals + 1);
         {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
+            float dx = points[0].x - points[points_count - 1].x;
+            float dy = points[0].y - points[points_count - 1].y;
             IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
+            temp_normals[0].x = temp_normals[points_count].x = dy;
+            temp_normals[0].y = temp_normals[points_count].y = -dx;
         }
 
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
-
-            // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
-            _VtxWritePtr += 2;
+        // Average normals and add vertices
+        ImConvexFillWriteVerts(_VtxWritePtr, points, temp_normals, points_count, AA_SIZE * 0.5f, uv, col, col_trans);
+        _VtxWritePtr += vtx_count;
 
-            // Add indexes for fringes
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
-            _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
+        // Add indexes for fringes, the first one joins the last point to the first
+        {
+            const unsigned int i0 = (unsigned int)(points_count - 1) << 1;
+            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + i0); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx + i0);
+            _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx + i0); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx);
+            _IdxWritePtr += 6;
+        }
+        for (int i1 = 1; i1 < points_count; i1++)
+        {
+            const unsigned int idx = vtx_inner_idx + (i1 << 1); // Inner vertex of i1, followed by its outer vertex and preceded by those of i0 = i1 - 1
+            _IdxWritePtr[0] = (ImDrawIdx)(idx); _IdxWritePtr[1] = (ImDrawIdx)(idx - 2); _IdxWritePtr[2] = (ImDrawIdx)(idx - 1);
+            _IdxWritePtr[3] = (ImDrawIdx)(idx - 1); _IdxWritePtr[4] = (ImDrawIdx)(idx + 1); _IdxWritePtr[5] = (ImDrawIdx)(idx);
             _IdxWritePtr += 6;
         }
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
@@ -1101,6 +1329,182 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
     }
 }
 
+// Same geometry as AddConvexPolyFilled(), with the fringe offsets kept apart from the outline so the shape can be scaled without widening them
+void ImDrawInstanceShape::BuildConvexPolyFilled(const ImDrawList* draw_list, const ImVec2* points, const int points_count)
+{
+    Clear();
+    if (points_count < 3)
+        return;
+
+    if (draw_list->Flags & ImDrawListFlags_AntiAliasedFill)
+    {
+        const float AA_SIZE = draw_list->_FringeScale;
+        _Pos.resize(points_count * 2);
+        _Offset.resize(points_count * 2);
+        _ColMask.resize(points_count * 2);
+        _IdxBuffer.resize((points_count - 2) * 3 + points_count * 6);
+        ImDrawIdx* idx_write = _IdxBuffer.Data;
+
+        // Indices for fill, then vertices and indices for fringes, in the order AddConvexPolyFilled() writes them
+        for (int i = 2; i < points_count; i++)
+        {
+            idx_write[0] = (ImDrawIdx)(0); idx_write[1] = (ImDrawIdx)((i - 1) << 1); idx_write[2] = (ImDrawIdx)(i << 1);
+            idx_write += 3;
+        }
+        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+        {
+            // Normals of the edges ending and starting at i1
+            const int i2 = (i1 + 1) % points_count;
+            float n0_x = points[i1].x - points[i0].x;
+            float n0_y = points[i1].y - points[i0].y;
+            float n1_x = points[i2].x - points[i1].x;
+            float n1_y = points[i2].y - points[i1].y;
+            IM_NORMALIZE2F_OVER_ZERO(n0_x, n0_y);
+            IM_NORMALIZE2F_OVER_ZERO(n1_x, n1_y);
+
+            // Average normals
+            float dm_x = (n0_y + n1_y) * 0.5f;
+            float dm_y = -(n0_x + n1_x) * 0.5f;
+            IM_FIXNORMAL2F(dm_x, dm_y);
+            dm_x *= AA_SIZE * 0.5f;
+            dm_y *= AA_SIZE * 0.5f;
+
+            _Pos[i1 * 2 + 0] = _Pos[i1 * 2 + 1] = points[i1];
+            _Offset[i1 * 2 + 0] = ImVec2(-dm_x, -dm_y); _ColMask[i1 * 2 + 0] = ~0u;                // Inner
+            _Offset[i1 * 2 + 1] = ImVec2(dm_x, dm_y);   _ColMask[i1 * 2 + 1] = ~IM_COL32_A_MASK;   // Outer
+
+            idx_write[0] = (ImDrawIdx)((i1 << 1)); idx_write[1] = (ImDrawIdx)((i0 << 1)); idx_write[2] = (ImDrawIdx)((i0 << 1) + 1);
+            idx_write[3] = (ImDrawIdx)((i0 << 1) + 1); idx_write[4] = (ImDrawIdx)((i1 << 1) + 1); idx_write[5] = (ImDrawIdx)((i1 << 1));
+            idx_write += 6;
+        }
+    }
+    else
+    {
+        _Pos.resize(points_count);
+        _Offset.resize(points_count);
+        _ColMask.resize(points_count);
+        _IdxBuffer.resize((points_count - 2) * 3);
+        memcpy(_Pos.Data, points, (size_t)points_count * sizeof(ImVec2));
+        memset(_Offset.Data, 0, (size_t)points_count * sizeof(ImVec2));
+        memset(_ColMask.Data, 0xFF, (size_t)points_count * sizeof(ImU32));
+        for (int i = 2; i < points_count; i++)
+        {
+            _IdxBuffer[(i - 2) * 3 + 0] = (ImDrawIdx)(0); _IdxBuffer[(i - 2) * 3 + 1] = (ImDrawIdx)(i - 1); _IdxBuffer[(i - 2) * 3 + 2] = (ImDrawIdx)(i);
+        }
+    }
+}
+
+// Same outline as AddCircleFilled(), built on the draw list's path
+void ImDrawInstanceShape::BuildCircleFilled(ImDrawList* draw_list, float radius, int num_segments)
+{
+    IM_ASSERT(draw_list->_Path.Size == 0 && "Build shapes outside of Path functions, they use the draw list's path.");
+    Clear();
+    if (radius < 0.5f)
+        return;
+
+    if (num_segments <= 0)
+    {
+        draw_list->_PathArcToFastEx(ImVec2(0.0f, 0.0f), radius, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, 0);
+        draw_list->_Path.Size--;
+    }
+    else
+    {
+        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
+        const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
+        draw_list->PathArcTo(ImVec2(0.0f, 0.0f), radius, 0.0f, a_max, num_segments - 1);
+    }
+    BuildConvexPolyFilled(draw_list, draw_list->_Path.Data, draw_list->_Path.Size);
+    draw_list->_Path.Size = 0;
+}
+
+// Same geometry as AddRectFilled(): a plain quad without fringe unless rounded
+void ImDrawInstanceShape::BuildRectFilled(ImDrawList* draw_list, const ImVec2& p_min, const ImVec2& p_max, float rounding, ImDrawFlags flags)
+{
+    IM_ASSERT(draw_list->_Path.Size == 0 && "Build shapes outside of Path functions, they use the draw list's path.");
+    if (rounding < 0.5f || (flags & ImDrawFlags_RoundCornersMask_) == ImDrawFlags_RoundCornersNone)
+    {
+        Clear();
+        const ImVec2 pos[4] = { p_min, ImVec2(p_max.x, p_min.y), p_max, ImVec2(p_min.x, p_max.y) };
+        const ImDrawIdx idx[6] = { 0, 1, 2, 0, 2, 3 };
+        for (int i = 0; i < 4; i++)
+        {
+            _Pos.push_back(pos[i]);
+            _Offset.push_back(ImVec2(0.0f, 0.0f));
+            _ColMask.push_back(~0u);
+        }
+        for (int i = 0; i < 6; i++)
+            _IdxBuffer.push_back(idx[i]);
+        return;
+    }
+    draw_list->PathRect(p_min, p_max, rounding, flags);
+    BuildConvexPolyFilled(draw_list, draw_list->_Path.Data, draw_list->_Path.Size);
+    draw_list->_Path.Size = 0;
+}
+
+void ImDrawList::AddShapeInstances(const ImDrawInstanceShape* shape, const ImVec2* centers, const float* sizes, const ImU32* colors, int count)
+{
+    const int vtx_per_instance = shape->_Pos.Size;
+    const int idx_per_instance = shape->_IdxBuffer.Size;
+    if (count <= 0 || idx_per_instance == 0)
+        return;
+
+    // Grow the buffers once for all instances. With 16-bit indices, write batches a single VtxOffset can address:
+    // the first fills what is left of the current one, then PrimReserve() moves to a new VtxOffset for each, without reallocating.
+    const int batch_max = (sizeof(ImDrawIdx) == 2) ? ImMax(((1 << 16) - 1) / vtx_per_instance, 1) : count;
+    const int vtx_needed = VtxBuffer.Size + count * vtx_per_instance;
+    const int idx_needed = IdxBuffer.Size + count * idx_per_instance;
+    if (vtx_needed > VtxBuffer.Capacity)
+        VtxBuffer.reserve(VtxBuffer._grow_capacity(vtx_needed));
+    if (idx_needed > IdxBuffer.Capacity)
+        IdxBuffer.reserve(IdxBuffer._grow_capacity(idx_needed));
+
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    const ImVec2* shape_pos = shape->_Pos.Data;
+    const ImVec2* shape_offset = shape->_Offset.Data;
+    const ImU32* shape_col_mask = shape->_ColMask.Data;
+    const ImDrawIdx* shape_idx = shape->_IdxBuffer.Data;
+    for (int batch_start = 0, batch_count = 0; batch_start < count; batch_start += batch_count)
+    {
+        const int room = (sizeof(ImDrawIdx) == 2) ? ((1 << 16) - 1 - (int)_VtxCurrentIdx) / vtx_per_instance : count;
+        batch_count = ImMin(count - batch_start, (room > 0) ? room : batch_max);
+        PrimReserve(batch_count * idx_per_instance, batch_count * vtx_per_instance);
+        ImDrawVert* vtx_write = _VtxWritePtr;
+        ImDrawIdx* idx_write = _IdxWritePtr;
+        unsigned int vtx_current_idx = _VtxCurrentIdx;
+        int skipped = 0;
+        for (int n = batch_start; n < batch_start + batch_count; n++)
+        {
+            const ImU32 col = colors[n];
+            if ((col & IM_COL32_A_MASK) == 0)
+            {
+                skipped++;
+                continue;
+            }
+            const ImVec2 center = centers[n];
+            const float size = sizes ? sizes[n] : 1.0f;
+            for (int i = 0; i < vtx_per_instance; i++)
+            {
+                vtx_write[i].pos.x = center.x + shape_pos[i].x * size + shape_offset[i].x;
+                vtx_write[i].pos.y = center.y + shape_pos[i].y * size + shape_offset[i].y;
+                vtx_write[i].uv = uv;
+                vtx_write[i].col = col & shape_col_mask[i];
+            }
+            for (int i = 0; i < idx_per_instance; i++)
+                idx_write[i] = (ImDrawIdx)(vtx_current_idx + shape_idx[i]);
+            vtx_write += vtx_per_instance;
+            idx_write += idx_per_instance;
+            vtx_current_idx += vtx_per_instance;
+        }
+        _VtxWritePtr = vtx_write;
+        _IdxWritePtr = idx_write;
+        _VtxCurrentIdx = vtx_current_idx;
+
+        // Give back what skipped instances didn't use
+        if (skipped > 0)
+            PrimUnreserve(skipped * idx_per_instance, skipped * vtx_per_instance);
+    }
+}
+
 void ImDrawList::_PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step)
 {
     if (radius < 0.5f)
@@ -1157,10 +1561,7 @@ void ImDrawList::_PathArcToFastEx(const ImVec2& center, float radius, int a_min_
             if (sample_index >= IM_DRAWLIST_ARCFAST_SAMPLE_MAX)
                 sample_index -= IM_DRAWLIST_ARCFAST_SAMPLE_MAX;
 
-            const ImVec2 s = _Data->ArcFastVtx[sample_index];
-            out_ptr->x = center.x + s.x * radius;
-            out_ptr->y = center.y + s.y * radius;
-            out_ptr++;
+            *out_ptr++ = _Data->ArcFastVtx[sample_index];
         }
     }
     else
@@ -1171,10 +1572,7 @@ void ImDrawList::_PathArcToFastEx(const ImVec2& center, float radius, int a_min_
             if (sample_index < 0)
                 sample_index += IM_DRAWLIST_ARCFAST_SAMPLE_MAX;
 
-            const ImVec2 s = _Data->ArcFastVtx[sample_index];
-            out_ptr->x = center.x + s.x * radius;
-            out_ptr->y = center.y + s.y * radius;
-            out_ptr++;
+            *out_ptr++ = _Data->ArcFastVtx[sample_index];
         }
     }
 
@@ -1184,13 +1582,13 @@ void ImDrawList::_PathArcToFastEx(const ImVec2& center, float radius, int a_min_
         if (normalized_max_sample < 0)
             normalized_max_sample += IM_DRAWLIST_ARCFAST_SAMPLE_MAX;
 
-        const ImVec2 s = _Data->ArcFastVtx[normalized_max_sample];
-        out_ptr->x = center.x + s.x * radius;
-        out_ptr->y = center.y + s.y * radius;
-        out_ptr++;
+        *out_ptr++ = _Data->ArcFastVtx[normalized_max_sample];
     }
 
     IM_ASSERT_PARANOID(_Path.Data + _Path.Size == out_ptr);
+
+    // Gather unit circle samples above, then scale and offset them all at once
+    ImScalePoints(_Path.Data + (_Path.Size - samples), samples, center, radius);
 }
 
 void ImDrawList::_PathArcToN(const ImVec2& center, float radius, float a_min, float a_max, int num_segments)
@@ -2210,6 +2608,290 @@ void ImDrawListSplitter::SetCurrentChannel(ImDrawList* draw_list, int idx)
         draw_list->AddDrawCmd();
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] ImDrawList retained segments (ImDrawListCache)
+//-----------------------------------------------------------------------------
+// A scope records the vertices, indices and commands it adds on the first frame, then later frames append
+// that copy while the hash is unchanged. Commands are stored as runs of indices sharing a ClipRect/TextureId,
+// and merged into the current command on replay like regular primitives would be.
+//-----------------------------------------------------------------------------
+
+bool ImDrawList::BeginCachedSegment(ImDrawListCache* cache, ImU32 hash)
+{
+    // Mix in the state the geometry depends on besides what the caller hashed
+    hash = ImHashData(&_CmdHeader.ClipRect, sizeof(_CmdHeader.ClipRect), hash);
+    hash = ImHashData(&_CmdHeader.TextureId, sizeof(_CmdHeader.TextureId), hash);
+    hash = ImHashData(&_Data->TexUvWhitePixel, sizeof(_Data->TexUvWhitePixel), hash);
+    hash = ImHashData(&_FringeScale, sizeof(_FringeScale), hash);
+    hash = ImHashData(&Flags, sizeof(Flags), hash);
+
+    if (!cache->_Valid || cache->_Hash != hash)
+    {
+        // Record: the scope is submitted, EndCachedSegment() copies what it added
+        cache->_Hash = hash;
+        cache->_Valid = false;
+        cache->_VtxBase = _VtxCurrentIdx;
+        cache->_RecCmdCount = CmdBuffer.Size;
+        cache->_RecVtxStart = VtxBuffer.Size;
+        cache->_RecIdxStart = IdxBuffer.Size;
+        cache->_RecVtxOffset = _CmdHeader.VtxOffset;
+        cache->_RecClipRectStackSize = _ClipRectStack.Size;
+        cache->_RecTextureIdStackSize = _TextureIdStack.Size;
+        return true;
+    }
+
+    // Replay: append vertices and indices in one go. With 16-bit indices this may start a new VtxOffset, so read the base after reserving.
+    const int vtx_count = cache->_VtxBuffer.Size;
+    const int idx_count = cache->_IdxBuffer.Size;
+    PrimReserve(idx_count, vtx_count);
+    CmdBuffer.Data[CmdBuffer.Size - 1].ElemCount -= idx_count; // Handed out to the cached runs below
+    memcpy(_VtxWritePtr, cache->_VtxBuffer.Data, (size_t)vtx_count * sizeof(ImDrawVert));
+    const unsigned int vtx_rebase = _VtxCurrentIdx - cache->_VtxBase;
+    if (vtx_rebase == 0)
+        memcpy(_IdxWritePtr, cache->_IdxBuffer.Data, (size_t)idx_count * sizeof(ImDrawIdx));
+    else
+        for (int n = 0; n < idx_count; n++)
+            _IdxWritePtr[n] = (ImDrawIdx)(cache->_IdxBuffer.Data[n] + vtx_rebase);
+    _VtxWritePtr += vtx_count;
+    _IdxWritePtr += idx_count;
+    _VtxCurrentIdx += vtx_count;
+
+    // Runs go into the current command when it has the same ClipRect/TextureId or is still empty, otherwise into a new one
+    for (const ImDrawCmd& run : cache->_CmdBuffer)
+    {
+        ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+        if (curr_cmd->ElemCount != 0 && (memcmp(&curr_cmd->ClipRect, &run.ClipRect, sizeof(ImVec4)) != 0 || curr_cmd->TextureId != run.TextureId))
+        {
+            ImDrawCmd draw_cmd;
+            draw_cmd.VtxOffset = _CmdHeader.VtxOffset;
+            draw_cmd.IdxOffset = curr_cmd->IdxOffset + curr_cmd->ElemCount;
+            CmdBuffer.push_back(draw_cmd);
+            curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+        }
+        curr_cmd->ClipRect = run.ClipRect;
+        curr_cmd->TextureId = run.TextureId;
+        curr_cmd->ElemCount += run.ElemCount;
+    }
+
+    // The scope ended with the same ClipRect/TextureId it started with, restore them as the current command's
+    ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
+    if (curr_cmd->ElemCount == 0)
+        ImDrawCmd_HeaderCopy(curr_cmd, &_CmdHeader);
+    else if (ImDrawCmd_HeaderCompare(curr_cmd, &_CmdHeader) != 0)
+        AddDrawCmd();
+    return false;
+}
+
+void ImDrawList::EndCachedSegment(ImDrawListCache* cache)
+{
+    IM_ASSERT(_ClipRectStack.Size == cache->_RecClipRectStackSize && _TextureIdStack.Size == cache->_RecTextureIdStackSize && "Mismatched PushClipRect()/PushTextureID() within a cached segment");
+    IM_ASSERT(VtxBuffer.Size >= cache->_RecVtxStart && IdxBuffer.Size >= cache->_RecIdxStart && "Cached segments must not switch channels");
+    cache->_VtxBuffer.resize(0);
+    cache->_IdxBuffer.resize(0);
+    cache->_CmdBuffer.resize(0);
+
+    // Indices of a scope spanning two VtxOffset can't be rebased together, and callbacks need to be called again. Retry next frame.
+    if (_CmdHeader.VtxOffset != cache->_RecVtxOffset)
+        return;
+    for (int cmd_n = ImMax(cache->_RecCmdCount - 1, 0); cmd_n < CmdBuffer.Size; cmd_n++)
+        if (CmdBuffer.Data[cmd_n].UserCallback != NULL)
+            return;
+
+    // Split the indices added since BeginCachedSegment() into runs, by walking back to the command holding the first one.
+    // The first command may also hold indices from before the scope, and merging may have removed the command current at the time.
+    const int idx_start = cache->_RecIdxStart;
+    const int idx_count = IdxBuffer.Size - idx_start;
+    int runs_idx_count = 0;
+    int cmd_n = CmdBuffer.Size - 1;
+    while (cmd_n > 0 && (int)CmdBuffer.Data[cmd_n].IdxOffset > idx_start)
+        cmd_n--;
+    for (; cmd_n < CmdBuffer.Size; cmd_n++)
+    {
+        const ImDrawCmd* cmd = &CmdBuffer.Data[cmd_n];
+        const int run_start = ImMax((int)cmd->IdxOffset, idx_start);
+        const int run_end = (int)(cmd->IdxOffset + cmd->ElemCount);
+        if (run_end <= run_start)
+            continue;
+        ImDrawCmd run;
+        run.ClipRect = cmd->ClipRect;
+        run.TextureId = cmd->TextureId;
+        run.ElemCount = (unsigned int)(run_end - run_start);
+        cache->_CmdBuffer.push_back(run);
+        runs_idx_count += run_end - run_start;
+    }
+    if (runs_idx_count != idx_count) // Never record something that wouldn't replay the same
+    {
+        cache->_CmdBuffer.resize(0);
+        return;
+    }
+
+    const int vtx_count = VtxBuffer.Size - cache->_RecVtxStart;
+    cache->_VtxBuffer.resize(vtx_count);
+    cache->_IdxBuffer.resize(idx_count);
+    memcpy(cache->_VtxBuffer.Data, VtxBuffer.Data + cache->_RecVtxStart, (size_t)vtx_count * sizeof(ImDrawVert));
+    memcpy(cache->_IdxBuffer.Data, IdxBuffer.Data + idx_start, (size_t)idx_count * sizeof(ImDrawIdx));
+    cache->_Valid = true;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImDrawListParallel
+//-----------------------------------------------------------------------------
+// Each list is a regular ImDrawList with its own copy of the parent's ImDrawListSharedData: the copy holds the
+// same font, atlas UV and tessellation settings, while its TempBuffer, which AddPolyline()/AddConvexPolyFilled()
+// write to, is private to the list. Lists are then appended one after another, rebasing indices when needed.
+//-----------------------------------------------------------------------------
+
+// Append the geometry and commands of 'src' to 'dst', as if they had been submitted to 'dst' at this point
+static void ImDrawListAppend(ImDrawList* dst, const ImDrawList* src)
+{
+    bool has_callbacks = false;
+    for (const ImDrawCmd& src_cmd : src->CmdBuffer)
+        has_callbacks |= (src_cmd.UserCallback != NULL);
+    if (src->IdxBuffer.Size == 0 && !has_callbacks)
+        return;
+
+    // Rebase indices onto the current VtxOffset when they fit, so the appended commands can merge with the surrounding ones.
+    // Otherwise (16-bit indices) each command starts its own VtxOffset and indices are copied as-is.
+    const int vtx_base = dst->VtxBuffer.Size;
+    const int idx_base = dst->IdxBuffer.Size;
+    const int callbacks_data_base = dst->_CallbacksDataBuf.Size;
+    const bool rebase = sizeof(ImDrawIdx) == 4 || (vtx_base - (int)dst->_CmdHeader.VtxOffset) + src->VtxBuffer.Size <= (1 << 16);
+    IM_ASSERT((rebase || (dst->Flags & ImDrawListFlags_AllowVtxOffset)) && "Too many vertices in ImDrawList using 16-bit indices. Read comment in AddDrawListToDrawDataEx()");
+
+    dst->VtxBuffer.resize(vtx_base + src->VtxBuffer.Size);
+    memcpy(dst->VtxBuffer.Data + vtx_base, src->VtxBuffer.Data, (size_t)src->VtxBuffer.Size * sizeof(ImDrawVert));
+    dst->IdxBuffer.resize(idx_base + src->IdxBuffer.Size);
+    ImDrawIdx* idx_write = dst->IdxBuffer.Data + idx_base;
+    if (!rebase)
+        memcpy(idx_write, src->IdxBuffer.Data, (size_t)src->IdxBuffer.Size * sizeof(ImDrawIdx));
+    if (src->_CallbacksDataBuf.Size > 0)
+    {
+        dst->_CallbacksDataBuf.resize(callbacks_data_base + src->_CallbacksDataBuf.Size);
+        memcpy(dst->_CallbacksDataBuf.Data + callbacks_data_base, src->_CallbacksDataBuf.Data, (size_t)src->_CallbacksDataBuf.Size);
+    }
+
+    // Drop the current command if nothing was added to it, then append commands, merging them when they can be drawn together
+    if (dst->CmdBuffer.Size > 0 && dst->CmdBuffer.back().ElemCount == 0 && dst->CmdBuffer.back().UserCallback == NULL)
+        dst->CmdBuffer.pop_back();
+    for (const ImDrawCmd& src_cmd : src->CmdBuffer)
+    {
+        if (src_cmd.ElemCount == 0 && src_cmd.UserCallback == NULL)
+            continue;
+        ImDrawCmd cmd = src_cmd;
+        cmd.IdxOffset += idx_base;
+        if (cmd.UserCallback != NULL && cmd.UserCallbackDataSize > 0)
+            cmd.UserCallbackDataOffset += callbacks_data_base; // UserCallbackData is resolved during Render()
+        if (rebase)
+        {
+            cmd.VtxOffset = dst->_CmdHeader.VtxOffset;
+            const unsigned int vtx_rebase = (unsigned int)vtx_base + src_cmd.VtxOffset - cmd.VtxOffset;
+            for (unsigned int n = src_cmd.IdxOffset; n < src_cmd.IdxOffset + src_cmd.ElemCount; n++)
+                idx_write[n] = (ImDrawIdx)(src->IdxBuffer.Data[n] + vtx_rebase);
+        }
+        else
+        {
+            cmd.VtxOffset += vtx_base;
+        }
+
+        ImDrawCmd* prev_cmd = (dst->CmdBuffer.Size > 0) ? &dst->CmdBuffer.back() : NULL;
+        if (prev_cmd != NULL && ImDrawCmd_HeaderCompare(prev_cmd, &cmd) == 0 && ImDrawCmd_AreSequentialIdxOffset(prev_cmd, (&cmd)) && prev_cmd->UserCallback == NULL && cmd.UserCallback == NULL)
+            prev_cmd->ElemCount += cmd.ElemCount;
+        else
+            dst->CmdBuffer.push_back(cmd);
+    }
+
+    // Carry on after the appended vertices, in a command matching the current ClipRect/TextureId/VtxOffset
+    if (!rebase)
+        dst->_CmdHeader.VtxOffset = dst->VtxBuffer.Size;
+    dst->_VtxCurrentIdx = (unsigned int)dst->VtxBuffer.Size - dst->_CmdHeader.VtxOffset;
+    dst->_VtxWritePtr = dst->VtxBuffer.Data + dst->VtxBuffer.Size;
+    dst->_IdxWritePtr = dst->IdxBuffer.Data + dst->IdxBuffer.Size;
+    ImDrawCmd* curr_cmd = (dst->CmdBuffer.Size > 0) ? &dst->CmdBuffer.back() : NULL;
+    if (curr_cmd == NULL || curr_cmd->UserCallback != NULL || ImDrawCmd_HeaderCompare(curr_cmd, &dst->_CmdHeader) != 0)
+        dst->AddDrawCmd();
+}
+
+void ImDrawListParallel::ClearFreeMemory()
+{
+    IM_ASSERT(!_Building && "Call End() before freeing draw lists that workers may be filling.");
+    for (int n = 0; n < _Lists.Size; n++)
+    {
+        IM_DELETE(_Lists[n]);
+        IM_DELETE(_SharedData[n]);
+    }
+    _Lists.clear();
+    _SharedData.clear();
+    _Count = 0;
+}
+
+void ImDrawListParallel::Begin(ImDrawList* parent, int count)
+{
+    IM_ASSERT(!_Building && "Call End() before calling Begin() again.");
+    IM_ASSERT(count > 0);
+    while (_Lists.Size < count)
+    {
+        _SharedData.push_back(IM_NEW(ImDrawListSharedData)());
+        _Lists.push_back(IM_NEW(ImDrawList)(_SharedData.back()));
+    }
+
+    const ImVec4 clip_rect = parent->_CmdHeader.ClipRect;
+    for (int n = 0; n < count; n++)
+    {
+        // Copy the parent's shared data but for the scratch buffer, each list keeps its own
+        ImDrawListSharedData* data = _SharedData[n];
+        ImVector<ImVec2> temp_buffer;
+        temp_buffer.swap(data->TempBuffer);
+        memcpy((void*)data, parent->_Data, sizeof(*data));
+        memset((void*)&data->TempBuffer, 0, sizeof(data->TempBuffer));
+        data->TempBuffer.swap(temp_buffer);
+
+        ImDrawList* draw_list = _Lists[n];
+        draw_list->_ResetForNewFrame();
+        draw_list->Flags = parent->Flags;
+        draw_list->_FringeScale = parent->_FringeScale;
+        draw_list->PushTextureID(parent->_CmdHeader.TextureId);
+        draw_list->PushClipRect(ImVec2(clip_rect.x, clip_rect.y), ImVec2(clip_rect.z, clip_rect.w));
+    }
+
+    // Workers allocate through IM_ALLOC(), don't let them update the context's allocation counters concurrently
+    _Context = GImGui;
+    if (_Context != NULL)
+        _Context->DebugAllocHookSuspended++;
+    _Count = count;
+    _Building = true;
+}
+
+void ImDrawListParallel::End()
+{
+    IM_ASSERT(_Building && "Call Begin() first.");
+    for (int n = 0; n < _Count; n++)
+    {
+        ImDrawList* draw_list = _Lists[n];
+        IM_UNUSED(draw_list);
+        IM_ASSERT(draw_list->_ClipRectStack.Size == 1 && draw_list->_TextureIdStack.Size == 1 && "Mismatched PushClipRect()/PushTextureID() in a parallel draw list");
+        IM_ASSERT(draw_list->_Splitter._Count <= 1 && "Merge channels before End()");
+    }
+    if (_Context != NULL)
+        _Context->DebugAllocHookSuspended--;
+    _Context = NULL;
+    _Building = false;
+}
+
+void ImDrawListParallel::MergeInto(ImDrawList* draw_list)
+{
+    IM_ASSERT(!_Building && "Call End() once all workers are done, before merging.");
+    for (int n = 0; n < _Count; n++)
+        ImDrawListAppend(draw_list, _Lists[n]);
+}
+
+void ImDrawListParallel::AddToDrawData(ImDrawData* draw_data)
+{
+    IM_ASSERT(!_Building && "Call End() once all workers are done, before adding to draw data.");
+    IM_ASSERT(draw_data->Valid && "Call after ImGui::Render().");
+    for (int n = 0; n < _Count; n++)
+        draw_data->AddDrawList(_Lists[n]);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImDrawData
 //-----------------------------------------------------------------------------
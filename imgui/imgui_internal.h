@@ -67,6 +67,19 @@ Index of this file:
 #include <nmmintrin.h>
 #endif
 #endif
+// Enable SIMD tessellation kernels in ImDrawList (see imgui_draw.cpp) if available. AVX implies the SSE kernels too, for tails.
+// Define IMGUI_DISABLE_SIMD_DRAWLIST to always use the scalar loops.
+#if !defined(IMGUI_DISABLE_SIMD_DRAWLIST)
+#if defined(IMGUI_ENABLE_SSE)
+#define IMGUI_ENABLE_SIMD_DRAWLIST_SSE
+#if defined(__AVX__)
+#define IMGUI_ENABLE_SIMD_DRAWLIST_AVX
+#endif
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define IMGUI_ENABLE_SIMD_DRAWLIST_NEON
+#include <arm_neon.h>
+#endif
+#endif
 // Emscripten has partial SSE 4.2 support where _mm_crc32_u32 is not available. See https://emscripten.org/docs/porting/simd.html#id11 and #8213
 #if defined(IMGUI_ENABLE_SSE4_2) && !defined(IMGUI_USE_LEGACY_CRC32_ADLER) && !defined(__EMSCRIPTEN__)
 #define IMGUI_ENABLE_SSE4_2_CRC
@@ -2406,6 +2419,7 @@ struct ImGuiContext
     ImGuiMetricsConfig      DebugMetricsConfig;
     ImGuiIDStackTool        DebugIDStackTool;
     ImGuiDebugAllocInfo     DebugAllocInfo;
+    int                     DebugAllocHookSuspended;            // > 0 while ImDrawListParallel lists may allocate from other threads. DebugAllocHook() isn't thread-safe, so allocations aren't counted meanwhile.
 
     // Misc
     float                   FramerateSecPerFrame[60];           // Calculate estimate of framerate for user over the last 60 frames..
@@ -0,0 +1,343 @@
+#pragma once
+
+// Standard library includes
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// ImGui includes
+#include "imgui.h"
+
+// Lo-RISE includes
+#include "entity_store.h"
+
+/**
+ * @brief Eases the drawn camera toward the one input asks for, so pans
+ * and zooms glide instead of jumping.
+ *
+ * Smoothing is exponential in time, covering the same share of the
+ * remaining distance per second whatever the frame rate. Zoom is eased
+ * in log space so zooming in and out feel the same.
+ */
+class CameraAnimator
+{
+public:
+    static constexpr float TIME_CONSTANT = 0.05f;   // Seconds to cover ~63% of the remaining distance
+    static constexpr float SNAP_PIXELS = 0.25f;     // Closer than this on screen is treated as arrived
+    static constexpr float SNAP_ZOOM = 1e-3f;       // Relative zoom difference treated as arrived
+
+    /**
+     * @brief Step toward the target camera by delta_time seconds, then
+     * replace the target with the camera to draw. The first call snaps.
+     */
+    void Update(
+        ImVec2& camera_pan,
+        float& camera_zoom,
+        const float delta_time)
+    {
+        if (started == false)
+        {
+            Snap(
+                camera_pan,
+                camera_zoom);
+        }
+
+        const float t = 1.0f - std::exp(-std::max(delta_time, 0.0f) / TIME_CONSTANT);
+        pan.x += (camera_pan.x - pan.x) * t;
+        pan.y += (camera_pan.y - pan.y) * t;
+        const float log_zoom = std::log(zoom);
+        zoom = std::exp(log_zoom + (std::log(camera_zoom) - log_zoom) * t);
+
+        // Pan is in world units, so compare at the drawn zoom
+        const float pan_pixels = std::max(
+            std::fabs(camera_pan.x - pan.x),
+            std::fabs(camera_pan.y - pan.y)) * zoom;
+
+        if (pan_pixels < SNAP_PIXELS &&
+            std::fabs(camera_zoom / zoom - 1.0f) < SNAP_ZOOM)
+        {
+            Snap(
+                camera_pan,
+                camera_zoom);
+        }
+        else
+        {
+            animating = true;
+        }
+
+        camera_pan = pan;
+        camera_zoom = zoom;
+    }
+
+    /**
+     * @brief Jump straight to the given camera.
+     */
+    void Snap(
+        const ImVec2 camera_pan,
+        const float camera_zoom)
+    {
+        pan = camera_pan;
+        zoom = camera_zoom;
+        started = true;
+        animating = false;
+    }
+
+    /**
+     * @brief Camera the last frame was drawn with. Before the first
+     * Update() nothing was drawn, and the arguments are left as they are.
+     */
+    void Drawn(
+        ImVec2& camera_pan,
+        float& camera_zoom) const
+    {
+        if (started == true)
+        {
+            camera_pan = pan;
+            camera_zoom = zoom;
+        }
+    }
+
+    /**
+     * @brief Whether the drawn camera is still catching up,
+     * and more frames are needed to get there.
+     */
+    bool Animating() const
+    {
+        return animating;
+    }
+
+private:
+    ImVec2 pan = ImVec2(0, 0);
+    float zoom = 1;
+    bool started = false;
+    bool animating = false;
+};
+
+/**
+ * @brief Drawn agent positions, eased between position samples.
+ *
+ * Telemetry moves agents a few times a second. Whenever an agent's
+ * position changes it glides there from where it is currently drawn,
+ * over the time since its previous sample (capped at MAX_DURATION), so
+ * agents reporting at a steady rate move continuously, one sample
+ * behind. Gliding from the drawn position means a late or irregular
+ * sample never makes an agent jump, and unlike extrapolating ahead it
+ * never overshoots a turn.
+ *
+ * Every per-agent value is its own packed array, and the per-frame
+ * blend is a branch-free loop over them that compilers vectorize.
+ * Changes are found by comparing the store against the last target,
+ * so any code path that moves agents is picked up.
+ */
+class MotionSmoother
+{
+public:
+    static constexpr float MAX_DURATION = 0.25f;        // Longest glide to a new sample, seconds
+    static constexpr float MIN_DURATION = 1.0f / 240;   // Shortest glide, when samples come in bursts
+    static constexpr float REBASE_TIME = 1024.0f;       // Times are kept small so floats stay precise
+
+    /**
+     * @brief Advance by delta_time seconds and blend every agent's drawn
+     * position. Call once per frame, before the positions are read.
+     */
+    void Update(
+        const EntityStore& agents,
+        const float delta_time)
+    {
+        const int old_size = std::min(Size(), agents.Size());
+        const float step = std::max(delta_time, 0.0f);
+        now += step;
+        if (now > REBASE_TIME)
+        {
+            Rebase();
+        }
+
+        Resize(agents.Size());
+
+        // New agents start where they are
+        for (int ii = old_size;
+            ii < Size();
+            ii++)
+        {
+            Snap(
+                ii,
+                agents.x[ii],
+                agents.y[ii]);
+        }
+
+        // Local copies, std::min() and std::max() would bind the class constants by reference
+        const float min_duration = MIN_DURATION;
+        const float max_duration = MAX_DURATION;
+        bool changed = false;
+        for (int ii = 0;
+            ii < old_size;
+            ii++)
+        {
+            if (agents.x[ii] == to_x[ii] &&
+                agents.y[ii] == to_y[ii])
+            {
+                continue;
+            }
+
+            const float duration = std::min(
+                std::max(now - start[ii], min_duration),
+                max_duration);
+
+            from_x[ii] = x[ii];
+            from_y[ii] = y[ii];
+            to_x[ii] = agents.x[ii];
+            to_y[ii] = agents.y[ii];
+
+            // The sample arrived during the frame that just passed, so the glide is
+            // already one step in. Starting at now would leave agents that get a
+            // sample every frame at t = 0, never moving.
+            start[ii] = now - step;
+            inv_duration[ii] = 1.0f / duration;
+            changed = true;
+        }
+
+        // Nothing in flight means the drawn positions are already the targets
+        if (changed == false &&
+            animating == false)
+        {
+            max_offset = 0;
+            return;
+        }
+
+        const int count = Size();
+        const float time = now;
+        const float* in_from_x = from_x.data();
+        const float* in_from_y = from_y.data();
+        const float* in_to_x = to_x.data();
+        const float* in_to_y = to_y.data();
+        const float* in_start = start.data();
+        const float* in_inv_duration = inv_duration.data();
+        float* out_x = x.data();
+        float* out_y = y.data();
+
+        float remaining = 0;
+        float offset = 0;
+        for (int ii = 0;
+            ii < count;
+            ii++)
+        {
+            float t = std::min((time - in_start[ii]) * in_inv_duration[ii], 1.0f);
+            float dx = (in_to_x[ii] - in_from_x[ii]) * (1.0f - t);
+            float dy = (in_to_y[ii] - in_from_y[ii]) * (1.0f - t);
+            out_x[ii] = in_to_x[ii] - dx;
+            out_y[ii] = in_to_y[ii] - dy;
+            remaining = std::max(remaining, 1.0f - t);
+            offset = std::max(offset, std::max(std::fabs(dx), std::fabs(dy)));
+        }
+
+        animating = remaining > 0;
+        max_offset = offset;
+    }
+
+    /**
+     * @brief Put an agent straight at its position, e.g. when its slot is
+     * reused. Does nothing for agents Update() hasn't seen yet.
+     */
+    void Snap(
+        const int agent,
+        const float pos_x,
+        const float pos_y)
+    {
+        if (agent >= Size())
+        {
+            return;
+        }
+
+        from_x[agent] = to_x[agent] = x[agent] = pos_x;
+        from_y[agent] = to_y[agent] = y[agent] = pos_y;
+        start[agent] = now - MAX_DURATION;
+        inv_duration[agent] = 1.0f / MAX_DURATION;
+    }
+
+    /**
+     * @brief Whether any agent is still gliding,
+     * and more frames are needed to get it there.
+     */
+    bool Animating() const
+    {
+        return animating;
+    }
+
+    /**
+     * @brief Largest distance along either axis between an agent's drawn
+     * position and its newest sample, which is where indices have it.
+     */
+    float MaxOffset() const
+    {
+        return max_offset;
+    }
+
+    /**
+     * @brief Drawn world positions, one per agent.
+     */
+    const float* X() const
+    {
+        return x.data();
+    }
+
+    const float* Y() const
+    {
+        return y.data();
+    }
+
+    int Size() const
+    {
+        return (int)x.size();
+    }
+
+private:
+    float now = 0;                      // Seconds since the last rebase
+    bool animating = false;
+    float max_offset = 0;               // See MaxOffset()
+
+    std::vector<float> from_x;          // Drawn position when the glide started
+    std::vector<float> from_y;
+    std::vector<float> to_x;            // Newest sample
+    std::vector<float> to_y;
+    std::vector<float> start;           // Time of the newest sample
+    std::vector<float> inv_duration;    // 1 / length of the glide
+    std::vector<float> x;               // Drawn position
+    std::vector<float> y;
+
+    /**
+     * @brief Match the agent count. Added agents are left for Update() to snap.
+     */
+    void Resize(
+        const int agent_count)
+    {
+        if (agent_count == Size())
+        {
+            return;
+        }
+
+        from_x.resize(agent_count);
+        from_y.resize(agent_count);
+        to_x.resize(agent_count);
+        to_y.resize(agent_count);
+        start.resize(agent_count);
+        inv_duration.resize(agent_count);
+        x.resize(agent_count);
+        y.resize(agent_count);
+    }
+
+    /**
+     * @brief Move the time origin to now. Glides that finished long
+     * ago are clamped, they only need to stay finished.
+     */
+    void Rebase()
+    {
+        for (int ii = 0;
+            ii < Size();
+            ii++)
+        {
+            start[ii] = std::max(start[ii] - now, -MAX_DURATION);
+        }
+
+        now = 0;
+    }
+};
@@ -0,0 +1,1276 @@
+// Lo-RISE headless benchmark
+// (create an ImGui context with no platform or renderer backend, populate the Lo-RISE view with
+// synthetic agents and tactics, script pan/zoom/drag input and measure the CPU side of each frame)
+// Modelled on imgui/examples/example_null. Nothing is displayed.
+//
+// Usage: lorise_bench.out [--agents N] [--tactics N] [--frames N] [--width W] [--height H] [--seed S]
+//                         [--icons 0|1] [--record <session log>]
+//        lorise_bench.out --session <session log> [--speed F]
+//        lorise_bench.out --camera <points> [--seed S]
+//        lorise_bench.out --polyline <points> [--seed S]
+//        lorise_bench.out --parallel <points> [--seed S]
+//
+// --record writes the scripted run to a session log, --session replays a log
+// recorded here or by lorise.out instead of the script. --camera measures the
+// camera transform kernels (see camera.h) instead of whole frames, --polyline
+// the ImDrawList::AddPolyline() and filled shape tessellation paths, --parallel
+// a scatter plot built on worker threads with ImDrawListParallel. --icons 0
+// leaves the icon atlas out, so agents are drawn as tessellated outlines.
+
+// Standard library includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+// ImGui includes
+#include "imgui.h"
+
+// Lo-RISE includes
+#include "lorise.h"
+#include "recorder.h"
+
+// Every heap allocation made by the process, including std containers.
+// Counted atomically, --parallel allocates from worker threads. Kept out
+// of line so GCC doesn't pair an inlined malloc() with a called delete and
+// warn about mismatched allocation functions.
+static std::atomic<int64_t> g_allocations{0};
+
+__attribute__((noinline)) void* operator new(size_t size)
+{
+    g_allocations++;
+    void* ptr = malloc(size > 0 ? size : 1);
+    if (ptr == NULL)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+__attribute__((noinline)) void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+// Allocations made through ImGui (draw lists, ImVector, etc.)
+static std::atomic<int64_t> g_imgui_allocations{0};
+
+static void* BenchMalloc(size_t size, void*)
+{
+    g_imgui_allocations++;
+    return malloc(size);
+}
+
+static void BenchFree(void* ptr, void*)
+{
+    free(ptr);
+}
+
+/**
+ * @brief Scripted user interaction, one mouse gesture per step.
+ */
+enum StepKind
+{
+    StepIdle,
+    StepPan,
+    StepZoomIn,
+    StepZoomOut,
+    StepDragTactic,
+    StepBoxSelect,
+    StepDragSelection
+};
+
+struct ScriptStep
+{
+    const char* name;
+    StepKind kind;
+};
+
+/**
+ * @brief Measurements of one frame.
+ */
+struct FrameStats
+{
+    double ms;
+    int vertices;
+    int indices;
+    int64_t allocations;
+    int64_t imgui_allocations;
+};
+
+static double Percentile(
+    std::vector<double> values,
+    const double pct)
+{
+    if (values.empty() == true)
+    {
+        return 0;
+    }
+
+    std::sort(
+        values.begin(),
+        values.end());
+
+    size_t index = (size_t)(pct / 100.0 * (double)(values.size() - 1) + 0.5);
+    return values[index];
+}
+
+static void PrintStats(
+    const char* label,
+    const std::vector<FrameStats>& frames)
+{
+    if (frames.empty() == true)
+    {
+        return;
+    }
+
+    std::vector<double> ms;
+    double ms_sum = 0;
+    double vtx_sum = 0;
+    double idx_sum = 0;
+    double alloc_sum = 0;
+    double imgui_alloc_sum = 0;
+    for (const FrameStats& frame : frames)
+    {
+        ms.push_back(frame.ms);
+        ms_sum += frame.ms;
+        vtx_sum += frame.vertices;
+        idx_sum += frame.indices;
+        alloc_sum += (double)frame.allocations;
+        imgui_alloc_sum += (double)frame.imgui_allocations;
+    }
+
+    double count = (double)frames.size();
+    printf("%-12s ms mean %7.3f  p50 %7.3f  p90 %7.3f  p99 %7.3f  max %7.3f | vtx %9.0f  idx %9.0f | allocs %7.1f (imgui %7.1f)\n",
+        label,
+        ms_sum / count,
+        Percentile(ms, 50),
+        Percentile(ms, 90),
+        Percentile(ms, 99),
+        Percentile(ms, 100),
+        vtx_sum / count,
+        idx_sum / count,
+        alloc_sum / count,
+        imgui_alloc_sum / count);
+}
+
+/**
+ * @brief Queue the input events for frame `frame` of a step lasting `frames` frames.
+ */
+static void FeedInput(
+    ImGuiIO& io,
+    const LoRISEState& state,
+    const StepKind kind,
+    const int frame,
+    const int frames,
+    ImVec2& mouse_pos)
+{
+    ImVec2 center = ImVec2(
+        io.DisplaySize.x / 2,
+        io.DisplaySize.y / 2);
+
+    ImGuiMouseButton button = kind == StepZoomIn || kind == StepZoomOut ?
+        ImGuiMouseButton_Right :
+        ImGuiMouseButton_Left;
+
+    if (kind == StepIdle)
+    {
+        return;
+    }
+
+    // Press on the first frame, move in between, release on the last
+    if (frame == 0)
+    {
+        // Aim at where things are drawn, like a user would
+        ImVec2 camera_pan = state.camera_pan;
+        float camera_zoom = state.camera_zoom;
+        state.camera_animator.Drawn(
+            camera_pan,
+            camera_zoom);
+
+        CameraTransform camera = CameraTransform(
+            ImVec2(0, 0),
+            center,
+            camera_pan,
+            camera_zoom);
+
+        mouse_pos = center;
+        if (kind == StepDragTactic)
+        {
+            mouse_pos = camera.WorldToScreen(state.tactics.GetPos(0));
+        }
+        else if (kind == StepBoxSelect)
+        {
+            mouse_pos = ImVec2(
+                center.x / 4,
+                center.y / 4);
+        }
+        else if (kind == StepDragSelection)
+        {
+            // Grab the first selected agent
+            int grabbed = -1;
+            state.selected_agents.ForEach(
+                [&](int index)
+                {
+                    grabbed = grabbed == -1 ? index : grabbed;
+                });
+
+            if (grabbed != -1)
+            {
+                mouse_pos = camera.WorldToScreen(state.agents.GetPos(grabbed));
+            }
+        }
+
+        io.AddKeyEvent(ImGuiMod_Shift, kind == StepBoxSelect);
+        io.AddMousePosEvent(mouse_pos.x, mouse_pos.y);
+        io.AddMouseButtonEvent(button, true);
+        return;
+    }
+
+    if (frame == frames - 1)
+    {
+        io.AddMouseButtonEvent(button, false);
+        return;
+    }
+
+    switch (kind)
+    {
+    case StepPan:           mouse_pos.x += 6.0f; mouse_pos.y += 3.0f; break;
+    case StepZoomIn:        mouse_pos.y -= 2.0f; break;
+    case StepZoomOut:       mouse_pos.y += 4.0f; break;
+    case StepDragTactic:    mouse_pos.x -= 3.0f; mouse_pos.y += 2.0f; break;
+    case StepBoxSelect:     mouse_pos.x += 24.0f; mouse_pos.y += 14.0f; break;
+    case StepDragSelection: mouse_pos.x += 3.0f; mouse_pos.y -= 2.0f; break;
+    default:                break;
+    }
+
+    io.AddMousePosEvent(mouse_pos.x, mouse_pos.y);
+}
+
+/**
+ * @brief Measure one frame drawn by draw().
+ */
+template <typename DrawFunc>
+static FrameStats MeasureFrame(
+    ImGuiIO& io,
+    DrawFunc draw)
+{
+    int64_t allocations = g_allocations;
+    int64_t imgui_allocations = g_imgui_allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    io.DeltaTime = 1.0f / 60.0f;
+    ImGui::NewFrame();
+
+    draw();
+
+    ImGui::Render();
+
+    auto end = std::chrono::steady_clock::now();
+    ImDrawData* draw_data = ImGui::GetDrawData();
+
+    FrameStats stats;
+    stats.ms = std::chrono::duration<double, std::milli>(end - start).count();
+    stats.vertices = draw_data->TotalVtxCount;
+    stats.indices = draw_data->TotalIdxCount;
+    stats.imgui_allocations = g_imgui_allocations - imgui_allocations;
+    stats.allocations = g_allocations - allocations + stats.imgui_allocations;
+    return stats;
+}
+
+/**
+ * @brief Play a session log back frame by frame and measure every frame.
+ */
+static int RunSession(
+    ImGuiIO& io,
+    const char* session_path,
+    const double speed)
+{
+    SessionPlayer player;
+    if (player.Open(session_path) == false)
+    {
+        return 1;
+    }
+
+    if (speed == 0)
+    {
+        fprintf(stderr, "--speed can't be zero\n");
+        return 1;
+    }
+
+    io.DisplaySize = player.DisplaySize();
+
+    printf("LO-RISE bench: session %s, %d frames, %.2f s at %.2fx, %.0fx%.0f\n",
+        session_path,
+        player.FrameCount(),
+        player.Duration(),
+        speed,
+        io.DisplaySize.x,
+        io.DisplaySize.y);
+
+    bool show_lorise = true;
+    LoRISEState lorise;
+    std::vector<FrameStats> frames;
+
+    // Negative speeds play from the end back to the start
+    double end_time = speed < 0 ?
+        0 :
+        player.Duration();
+
+    player.Seek(
+        lorise,
+        player.Duration() - end_time);
+
+    bool done = false;
+    while (done == false)
+    {
+        done = player.Time() == end_time;
+
+        frames.push_back(MeasureFrame(
+            io,
+            [&]()
+            {
+                LoRISE(
+                    show_lorise,
+                    io,
+                    player.View(),
+                    lorise);
+            }));
+
+        player.Advance(
+            lorise,
+            io.DeltaTime,
+            speed);
+    }
+
+    PrintStats(
+        "session",
+        frames);
+
+    return 0;
+}
+
+/**
+ * @brief Time the best of repeats runs of a kernel over point_count points.
+ */
+template <typename KernelFunc>
+static void MeasureKernel(
+    const char* name,
+    const int point_count,
+    const int repeats,
+    KernelFunc kernel)
+{
+    double best_ms = -1;
+    for (int rr = 0;
+        rr < repeats;
+        rr++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        kernel();
+        auto end = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        best_ms = best_ms < 0 ? ms : std::min(best_ms, ms);
+    }
+
+    printf("%-12s ms best %7.3f | %8.1f Mpoints/s\n",
+        name,
+        best_ms,
+        point_count / (best_ms * 1000.0));
+}
+
+/**
+ * @brief Measure camera transform throughput over point_count random
+ * points, one ImVec2 at a time and in bulk over float arrays.
+ */
+static int RunCameraBench(
+    const int point_count,
+    const unsigned int seed)
+{
+    const int repeats = 20;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord(-100000.0f, 100000.0f);
+
+    std::vector<float> world_x(point_count);
+    std::vector<float> world_y(point_count);
+    for (int ii = 0;
+        ii < point_count;
+        ii++)
+    {
+        world_x[ii] = coord(rng);
+        world_y[ii] = coord(rng);
+    }
+
+    CameraTransform camera = CameraTransform(
+        ImVec2(0, 0),
+        ImVec2(960, 540),
+        ImVec2(1234.5f, -678.9f),
+        0.37f);
+
+    std::vector<float> point_x(point_count);
+    std::vector<float> point_y(point_count);
+    std::vector<float> screen_x(point_count);
+    std::vector<float> screen_y(point_count);
+    std::vector<float> back_x(point_count);
+    std::vector<float> back_y(point_count);
+
+    const char* kernel = "scalar";
+#if defined(LORISE_CAMERA_AVX)
+    kernel = "AVX";
+#elif defined(LORISE_CAMERA_SSE2)
+    kernel = "SSE2";
+#elif defined(LORISE_CAMERA_NEON)
+    kernel = "NEON";
+#endif
+
+    printf("LO-RISE bench: camera transform, %d points, %s kernel\n",
+        point_count,
+        kernel);
+
+    MeasureKernel(
+        "point",
+        point_count,
+        repeats,
+        [&]()
+        {
+            for (int ii = 0;
+                ii < point_count;
+                ii++)
+            {
+                ImVec2 pos = camera.WorldToScreen(ImVec2(world_x[ii], world_y[ii]));
+                point_x[ii] = pos.x;
+                point_y[ii] = pos.y;
+            }
+        });
+
+    MeasureKernel(
+        "to-screen",
+        point_count,
+        repeats,
+        [&]()
+        {
+            WorldToScreen(
+                camera,
+                world_x.data(),
+                world_y.data(),
+                screen_x.data(),
+                screen_y.data(),
+                point_count);
+        });
+
+    MeasureKernel(
+        "to-world",
+        point_count,
+        repeats,
+        [&]()
+        {
+            ScreenToWorld(
+                camera,
+                screen_x.data(),
+                screen_y.data(),
+                back_x.data(),
+                back_y.data(),
+                point_count);
+        });
+
+    // Bulk and single point results must agree exactly, the round trip within float precision
+    int mismatches = 0;
+    float max_round_trip = 0;
+    for (int ii = 0;
+        ii < point_count;
+        ii++)
+    {
+        mismatches += screen_x[ii] != point_x[ii] || screen_y[ii] != point_y[ii];
+        max_round_trip = std::max(
+            max_round_trip,
+            std::max(
+                std::fabs(back_x[ii] - world_x[ii]),
+                std::fabs(back_y[ii] - world_y[ii])));
+    }
+
+    printf("bulk vs point mismatches %d, max round trip error %g world units\n",
+        mismatches,
+        max_round_trip);
+
+    return mismatches == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Fill the Lo-RISE state with randomly placed entities around the view.
+ */
+static void GenerateEntities(
+    LoRISEState& state,
+    const ImVec2 display_size,
+    const int agent_count,
+    const int tactic_count,
+    const unsigned int seed)
+{
+    std::mt19937 rng(seed);
+
+    // Roughly a thousand agents on screen at 1x zoom for 10k agents
+    float side = std::sqrt((float)std::max(agent_count, 1)) * 40.0f;
+    std::uniform_real_distribution<float> coord_x(display_size.x / 2 - side / 2, display_size.x / 2 + side / 2);
+    std::uniform_real_distribution<float> coord_y(display_size.y / 2 - side / 2, display_size.y / 2 + side / 2);
+    std::uniform_int_distribution<int> coin(0, 1);
+
+    const ImU32 agent_colors[] = {
+        Agent::ALIVE_COLOR,
+        Agent::TASKED_COLOR,
+        Agent::DEAD_COLOR };
+
+    const ImU32 tactic_colors[] = {
+        Tactic::WIP_COLOR,
+        Tactic::COMPLETE_COLOR,
+        Tactic::FAILED_COLOR };
+
+    state.agents.Reserve(agent_count);
+    state.trails.Reset(agent_count);
+    for (int ii = 0;
+        ii < agent_count;
+        ii++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "AGENT-%d", ii);
+
+        ImU32 color = agent_colors[ii % 3];
+        AddAgent(
+            state.agents,
+            {
+                name,
+                coin(rng) == 1,
+                color == Agent::DEAD_COLOR,
+                ImVec2(coord_x(rng), coord_y(rng)),
+                color
+            });
+    }
+
+    // First tactic sits in the middle of the view so the drag step can grab it
+    state.tactics.Reserve(tactic_count);
+    for (int ii = 0;
+        ii < tactic_count;
+        ii++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "TACTIC-%d", ii);
+
+        ImVec2 pos = ii == 0 ?
+            ImVec2(display_size.x / 2, display_size.y / 2) :
+            ImVec2(coord_x(rng), coord_y(rng));
+
+        AddTactic(
+            state.tactics,
+            {
+                name,
+                pos,
+                tactic_colors[ii % 3]
+            });
+    }
+
+    IndexEntities(state);
+}
+
+/**
+ * @brief Measure ImDrawList::AddPolyline() throughput for each of its
+ * anti-aliased paths, over point_count random points split into
+ * polylines the length of a typical trail or plot segment. Then the
+ * anti-aliased fills of AddConvexPolyFilled(), as used by circles and
+ * rounded rects.
+ */
+static int RunPolylineBench(
+    ImGuiIO& io,
+    const int point_count,
+    const unsigned int seed)
+{
+    const int repeats = 20;
+    const int points_per_line = 64;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord_x(0.0f, io.DisplaySize.x);
+    std::uniform_real_distribution<float> coord_y(0.0f, io.DisplaySize.y);
+
+    std::vector<ImVec2> points(point_count);
+    for (int ii = 0;
+        ii < point_count;
+        ii++)
+    {
+        points[ii] = ImVec2(
+            coord_x(rng),
+            coord_y(rng));
+    }
+
+    const char* kernel = "scalar";
+#if defined(IMGUI_ENABLE_SIMD_DRAWLIST_AVX)
+    kernel = "AVX";
+#elif defined(IMGUI_ENABLE_SIMD_DRAWLIST_SSE)
+    kernel = "SSE";
+#elif defined(IMGUI_ENABLE_SIMD_DRAWLIST_NEON)
+    kernel = "NEON";
+#endif
+
+    printf("LO-RISE bench: AddPolyline, %d points in lines of %d, %s kernel\n",
+        point_count,
+        points_per_line,
+        kernel);
+
+    // Shared data only has the baked line textures once a frame has started
+    ImGui::NewFrame();
+    ImDrawList draw_list(ImGui::GetDrawListSharedData());
+
+    struct PolylineCase
+    {
+        const char* name;
+        ImDrawListFlags flags;
+        float thickness;
+        ImDrawFlags draw_flags;
+    };
+
+    const ImDrawListFlags aa = ImDrawListFlags_AntiAliasedLines;
+    const ImDrawListFlags aa_tex = ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex;
+    const PolylineCase cases[] = {
+        { "thin-tex",   aa_tex, 1.0f, ImDrawFlags_None },
+        { "thin",       aa,     1.0f, ImDrawFlags_None },
+        { "thin-loop",  aa,     1.0f, ImDrawFlags_Closed },
+        { "thick-tex",  aa_tex, 3.0f, ImDrawFlags_None },
+        { "thick",      aa,     3.0f, ImDrawFlags_None },
+        { "thick-frac", aa_tex, 2.5f, ImDrawFlags_None } };
+
+    for (const PolylineCase& test : cases)
+    {
+        MeasureKernel(
+            test.name,
+            point_count,
+            repeats,
+            [&]()
+            {
+                draw_list._ResetForNewFrame();
+                draw_list.PushClipRectFullScreen();
+                draw_list.PushTextureID(io.Fonts->TexID);
+                draw_list.Flags = test.flags | ImDrawListFlags_AllowVtxOffset;
+
+                for (int start = 0;
+                    start + 2 <= point_count;
+                    start += points_per_line)
+                {
+                    draw_list.AddPolyline(
+                        &points[start],
+                        std::min(points_per_line, point_count - start),
+                        IM_COL32(255, 160, 0, 255),
+                        test.draw_flags,
+                        test.thickness);
+                }
+            });
+    }
+
+    // Anti-aliased fills, one shape per point sized like a radio button or a
+    // rounded frame, or convex polygons over the same lines as above. The
+    // inst- cases draw the same shapes in one AddShapeInstances() call.
+    enum FillShape
+    {
+        FillCircle,
+        FillRoundedRect,
+        FillConvex,
+        InstancedCircle,
+        InstancedRoundedRect
+    };
+
+    struct FillCase
+    {
+        const char* name;
+        FillShape shape;
+        float radius;
+    };
+
+    const FillCase fill_cases[] = {
+        { "fill-circle", FillCircle,           6.0f },
+        { "fill-rrect",  FillRoundedRect,      4.0f },
+        { "fill-convex", FillConvex,           0.0f },
+        { "inst-circle", InstancedCircle,      6.0f },
+        { "inst-rrect",  InstancedRoundedRect, 4.0f } };
+
+    std::vector<ImU32> colors(
+        point_count,
+        IM_COL32(255, 160, 0, 255));
+
+    ImDrawInstanceShape shape;
+
+    for (const FillCase& test : fill_cases)
+    {
+        MeasureKernel(
+            test.name,
+            point_count,
+            repeats,
+            [&]()
+            {
+                draw_list._ResetForNewFrame();
+                draw_list.PushClipRectFullScreen();
+                draw_list.PushTextureID(io.Fonts->TexID);
+                draw_list.Flags = ImDrawListFlags_AntiAliasedFill | ImDrawListFlags_AllowVtxOffset;
+
+                if (test.shape == FillConvex)
+                {
+                    for (int start = 0;
+                        start + 3 <= point_count;
+                        start += points_per_line)
+                    {
+                        draw_list.AddConvexPolyFilled(
+                            &points[start],
+                            std::min(points_per_line, point_count - start),
+                            IM_COL32(255, 160, 0, 255));
+                    }
+
+                    return;
+                }
+
+                if (test.shape == InstancedCircle ||
+                    test.shape == InstancedRoundedRect)
+                {
+                    if (test.shape == InstancedCircle)
+                    {
+                        shape.BuildCircleFilled(
+                            &draw_list,
+                            test.radius);
+                    }
+                    else
+                    {
+                        shape.BuildRectFilled(
+                            &draw_list,
+                            ImVec2(0, 0),
+                            ImVec2(100, 20),
+                            test.radius);
+                    }
+
+                    draw_list.AddShapeInstances(
+                        &shape,
+                        points.data(),
+                        NULL,
+                        colors.data(),
+                        point_count);
+
+                    return;
+                }
+
+                for (int ii = 0;
+                    ii < point_count;
+                    ii++)
+                {
+                    if (test.shape == FillCircle)
+                    {
+                        draw_list.AddCircleFilled(
+                            points[ii],
+                            test.radius,
+                            IM_COL32(255, 160, 0, 255));
+                    }
+                    else
+                    {
+                        draw_list.AddRectFilled(
+                            points[ii],
+                            ImVec2(
+                                points[ii].x + 100,
+                                points[ii].y + 20),
+                            IM_COL32(255, 160, 0, 255),
+                            test.radius);
+                    }
+                }
+            });
+    }
+
+    ImGui::EndFrame();
+    return 0;
+}
+
+/**
+ * @brief A vertex of a draw data's triangles, resolved through its
+ * command, so draw data can be compared however it is split into
+ * draw lists, commands and VtxOffset ranges.
+ */
+struct FlatVertex
+{
+    ImDrawVert vtx;
+    ImVec4 clip_rect;
+    ImTextureID texture_id;
+};
+
+static void FlattenDrawData(
+    const ImDrawData* draw_data,
+    std::vector<FlatVertex>& out)
+{
+    out.clear();
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+        {
+            if (cmd.UserCallback != NULL)
+            {
+                continue;
+            }
+
+            for (unsigned int ii = 0;
+                ii < cmd.ElemCount;
+                ii++)
+            {
+                FlatVertex vertex;
+                vertex.vtx = draw_list->VtxBuffer[cmd.VtxOffset + draw_list->IdxBuffer[cmd.IdxOffset + ii]];
+                vertex.clip_rect = cmd.ClipRect;
+                vertex.texture_id = cmd.TextureId;
+                out.push_back(vertex);
+            }
+        }
+    }
+}
+
+static bool SameDrawData(
+    const std::vector<FlatVertex>& a,
+    const std::vector<FlatVertex>& b)
+{
+    if (a.size() != b.size())
+    {
+        return false;
+    }
+
+    for (size_t ii = 0;
+        ii < a.size();
+        ii++)
+    {
+        if (memcmp(&a[ii].vtx, &b[ii].vtx, sizeof(ImDrawVert)) != 0 ||
+            memcmp(&a[ii].clip_rect, &b[ii].clip_rect, sizeof(ImVec4)) != 0 ||
+            a[ii].texture_id != b[ii].texture_id)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Build a scatter plot of point_count points split into one draw
+ * list per core, filled on worker threads with ImDrawListParallel, then
+ * merged into the window's draw list or appended to the draw data. Each
+ * way is timed against drawing the same points on the UI thread, and
+ * its draw data checked to be the same triangles.
+ */
+static int RunParallelBench(
+    ImGuiIO& io,
+    const int point_count,
+    const unsigned int seed)
+{
+    const int repeats = 20;
+    const int list_count = std::max((int)std::thread::hardware_concurrency(), 4);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coord_x(0.0f, io.DisplaySize.x);
+    std::uniform_real_distribution<float> coord_y(0.0f, io.DisplaySize.y);
+
+    std::vector<ImVec2> points(point_count);
+    std::vector<ImU32> colors(point_count);
+    for (int ii = 0;
+        ii < point_count;
+        ii++)
+    {
+        points[ii] = ImVec2(
+            coord_x(rng),
+            coord_y(rng));
+
+        colors[ii] = IM_COL32(255, 160, 0, 255) - (ImU32)(ii % 64);
+    }
+
+    printf("LO-RISE bench: scatter plot, %d points in %d draw lists, %d-bit indices\n",
+        point_count,
+        list_count,
+        (int)sizeof(ImDrawIdx) * 8);
+
+    // Points of list ll, drawn like a plot marker
+    auto draw_slice = [&](
+        ImDrawList* draw_list,
+        const int ll)
+    {
+        int start = (int)((int64_t)point_count * ll / list_count);
+        int end = (int)((int64_t)point_count * (ll + 1) / list_count);
+        for (int ii = start;
+            ii < end;
+            ii++)
+        {
+            draw_list->AddCircleFilled(
+                points[ii],
+                3.0f,
+                colors[ii]);
+        }
+    };
+
+    enum BuildMode
+    {
+        Sequential,         // Every point into the window's draw list, on this thread
+        ParallelMerge,      // Worker lists merged into the window's draw list
+        SequentialLists,    // Separate lists filled on this thread, added to the draw data
+        ParallelDrawData    // Worker lists added to the draw data
+    };
+
+    ImDrawListParallel parallel;
+    std::vector<ImDrawList*> sequential_lists;
+    for (int ll = 0;
+        ll < list_count;
+        ll++)
+    {
+        sequential_lists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+    }
+
+    auto frame = [&](
+        const BuildMode mode)
+    {
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin(
+            "##scatter",
+            NULL,
+            ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoBackground);
+
+        ImDrawList* window_list = ImGui::GetWindowDrawList();
+        ImDrawCmdHeader header = window_list->_CmdHeader;
+        if (mode == Sequential)
+        {
+            for (int ll = 0;
+                ll < list_count;
+                ll++)
+            {
+                draw_slice(
+                    window_list,
+                    ll);
+            }
+        }
+        else if (mode == ParallelMerge ||
+            mode == ParallelDrawData)
+        {
+            parallel.Begin(
+                window_list,
+                list_count);
+
+            std::vector<std::thread> workers;
+            for (int ll = 0;
+                ll < list_count;
+                ll++)
+            {
+                workers.emplace_back(
+                    [&, ll]()
+                    {
+                        draw_slice(
+                            parallel.GetDrawList(ll),
+                            ll);
+                    });
+            }
+
+            for (std::thread& worker : workers)
+            {
+                worker.join();
+            }
+
+            parallel.End();
+            if (mode == ParallelMerge)
+            {
+                parallel.MergeInto(window_list);
+            }
+        }
+
+        ImGui::End();
+        ImGui::Render();
+
+        if (mode == ParallelDrawData)
+        {
+            parallel.AddToDrawData(ImGui::GetDrawData());
+        }
+        else if (mode == SequentialLists)
+        {
+            // Set up like ImDrawListParallel::Begin() does
+            for (int ll = 0;
+                ll < list_count;
+                ll++)
+            {
+                ImDrawList* draw_list = sequential_lists[ll];
+                draw_list->_ResetForNewFrame();
+                draw_list->Flags = window_list->Flags;
+                draw_list->PushTextureID(header.TextureId);
+                draw_list->PushClipRect(
+                    ImVec2(header.ClipRect.x, header.ClipRect.y),
+                    ImVec2(header.ClipRect.z, header.ClipRect.w));
+
+                draw_slice(
+                    draw_list,
+                    ll);
+
+                ImGui::GetDrawData()->AddDrawList(draw_list);
+            }
+        }
+    };
+
+    struct ModeCase
+    {
+        const char* name;
+        BuildMode mode;
+        BuildMode reference;
+    };
+
+    const ModeCase cases[] = {
+        { "sequential", Sequential,       Sequential },
+        { "merge",      ParallelMerge,    Sequential },
+        { "seq-lists",  SequentialLists,  SequentialLists },
+        { "draw-data",  ParallelDrawData, SequentialLists } };
+
+    // First frame sets the window up
+    frame(Sequential);
+
+    int failures = 0;
+    std::vector<FlatVertex> expected;
+    std::vector<FlatVertex> result;
+    for (const ModeCase& test : cases)
+    {
+        MeasureKernel(
+            test.name,
+            point_count,
+            repeats,
+            [&]()
+            {
+                frame(test.mode);
+            });
+
+        int max_list_vertices = 0;
+        for (const ImDrawList* draw_list : ImGui::GetDrawData()->CmdLists)
+        {
+            max_list_vertices = std::max(max_list_vertices, draw_list->VtxBuffer.Size);
+        }
+
+        FlattenDrawData(
+            ImGui::GetDrawData(),
+            result);
+
+        frame(test.reference);
+        FlattenDrawData(
+            ImGui::GetDrawData(),
+            expected);
+
+        bool same = SameDrawData(
+            result,
+            expected);
+
+        printf("%-12s %d draw lists, up to %d vertices: %s\n",
+            "",
+            ImGui::GetDrawData()->CmdListsCount,
+            max_list_vertices,
+            same == true ?
+                "same as sequential" :
+                "DIFFERENT from sequential");
+
+        failures += same == true ? 0 : 1;
+    }
+
+    for (ImDrawList* draw_list : sequential_lists)
+    {
+        IM_DELETE(draw_list);
+    }
+
+    return failures > 0 ? 1 : 0;
+}
+
+int main(int argc, char** argv)
+{
+    int agent_count = 10000;
+    int tactic_count = 100;
+    int frames_per_step = 60;
+    int width = 1920;
+    int height = 1080;
+    unsigned int seed = 1;
+    const char* record_path = NULL;
+    const char* session_path = NULL;
+    double speed = 1.0;
+    int camera_points = 0;
+    int polyline_points = 0;
+    int parallel_points = 0;
+    bool icons = true;
+
+    for (int ii = 1;
+        ii + 1 < argc;
+        ii += 2)
+    {
+        if (strcmp(argv[ii], "--agents") == 0)              agent_count = atoi(argv[ii + 1]);
+        else if (strcmp(argv[ii], "--tactics") == 0)        tactic_count = std::max(atoi(argv[ii + 1]), 1);
+        else if (strcmp(argv[ii], "--frames") == 0)         frames_per_step = std::max(atoi(argv[ii + 1]), 2);
+        else if (strcmp(argv[ii], "--width") == 0)          width = atoi(argv[ii + 1]);
+        else if (strcmp(argv[ii], "--height") == 0)         height = atoi(argv[ii + 1]);
+        else if (strcmp(argv[ii], "--seed") == 0)           seed = (unsigned int)atoi(argv[ii + 1]);
+        else if (strcmp(argv[ii], "--record") == 0)         record_path = argv[ii + 1];
+        else if (strcmp(argv[ii], "--session") == 0)        session_path = argv[ii + 1];
+        else if (strcmp(argv[ii], "--speed") == 0)          speed = atof(argv[ii + 1]);
+        else if (strcmp(argv[ii], "--camera") == 0)         camera_points = std::max(atoi(argv[ii + 1]), 1);
+        else if (strcmp(argv[ii], "--polyline") == 0)       polyline_points = std::max(atoi(argv[ii + 1]), 2);
+        else if (strcmp(argv[ii], "--parallel") == 0)       parallel_points = std::max(atoi(argv[ii + 1]), 1);
+        else if (strcmp(argv[ii], "--icons") == 0)          icons = atoi(argv[ii + 1]) != 0;
+        else
+        {
+            fprintf(stderr, "Unknown option %s\n", argv[ii]);
+            return 1;
+        }
+    }
+
+    if (camera_points > 0)
+    {
+        return RunCameraBench(
+            camera_points,
+            seed);
+    }
+
+    ImGui::SetAllocatorFunctions(
+        BenchMalloc,
+        BenchFree);
+
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2((float)width, (float)height);
+
+    // Like the OpenGL3 backend, so draw lists past 64K vertices split on VtxOffset with 16-bit indices
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+    // Build atlas, with the agent icons unless asked not to
+    if (icons == false ||
+        InitIconAtlas(io.Fonts) == false)
+    {
+        unsigned char* tex_pixels = NULL;
+        int tex_w, tex_h;
+        io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+    }
+
+    if (polyline_points > 0)
+    {
+        int result = RunPolylineBench(
+            io,
+            polyline_points,
+            seed);
+
+        ImGui::DestroyContext();
+        return result;
+    }
+
+    if (parallel_points > 0)
+    {
+        int result = RunParallelBench(
+            io,
+            parallel_points,
+            seed);
+
+        ImGui::DestroyContext();
+        return result;
+    }
+
+    if (session_path != NULL)
+    {
+        int result = RunSession(
+            io,
+            session_path,
+            speed);
+
+        ImGui::DestroyContext();
+        return result;
+    }
+
+    bool show_lorise = true;
+    LoRISEState lorise;
+    GenerateEntities(
+        lorise,
+        io.DisplaySize,
+        agent_count,
+        tactic_count,
+        seed);
+
+    const ScriptStep script[] = {
+        { "idle",       StepIdle },
+        { "pan",        StepPan },
+        { "zoom-in",    StepZoomIn },
+        { "drag",       StepDragTactic },
+        { "select",     StepBoxSelect },
+        { "move-sel",   StepDragSelection },
+        { "zoom-out",   StepZoomOut },
+        { "idle-far",   StepIdle },
+        { "pan-far",    StepPan },
+        { "zoom-heat",  StepZoomOut },
+        { "idle-heat",  StepIdle } };
+
+    printf("LO-RISE bench: %d agents, %d tactics, %d frames per step, %dx%d, trails %.1f MB, %s icons\n",
+        agent_count,
+        tactic_count,
+        frames_per_step,
+        width,
+        height,
+        lorise.trails.MemoryBytes() / (1024.0 * 1024.0),
+        GetIconAtlas().ready == true ?
+            "atlas" :
+            "outline");
+
+    SessionRecorder recorder;
+    if (record_path != NULL)
+    {
+        recorder.Open(
+            record_path,
+            io.DisplaySize);
+    }
+
+    std::vector<FrameStats> all_frames;
+    ImVec2 mouse_pos = ImVec2(0, 0);
+    double time = 0;
+    for (const ScriptStep& step : script)
+    {
+        std::vector<FrameStats> step_frames;
+        for (int frame = 0;
+            frame < frames_per_step;
+            frame++)
+        {
+            FeedInput(
+                io,
+                lorise,
+                step.kind,
+                frame,
+                frames_per_step,
+                mouse_pos);
+
+            LoRISEView view;
+            step_frames.push_back(MeasureFrame(
+                io,
+                [&]()
+                {
+                    view = LoRISEFrame(
+                        show_lorise,
+                        io,
+                        lorise);
+                }));
+
+            // Recording is kept out of the measured frame
+            recorder.RecordFrame(
+                time,
+                view,
+                lorise);
+            time += io.DeltaTime;
+        }
+
+        PrintStats(
+            step.name,
+            step_frames);
+
+        all_frames.insert(
+            all_frames.end(),
+            step_frames.begin(),
+            step_frames.end());
+    }
+
+    PrintStats(
+        "total",
+        all_frames);
+
+    recorder.Close();
+    ImGui::DestroyContext();
+    return 0;
+}
@@ -0,0 +1,180 @@
+#pragma once
+
+// Standard library includes
+#if defined(__AVX2__) || defined(__AVX__)
+#include <immintrin.h>
+#define LORISE_CAMERA_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define LORISE_CAMERA_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define LORISE_CAMERA_NEON
+#endif
+
+// ImGui includes
+#include "imgui.h"
+
+/**
+ * @brief The Lo-RISE camera. Pans, then zooms about the center of the
+ * view, which folds into one scale and offset:
+ *
+ *   screen = origin + center + (world - pan - center) * zoom
+ *          = world * zoom + offset
+ *
+ * Everything that goes between world and screen space uses this,
+ * one point at a time or in bulk with TransformPoints().
+ */
+struct CameraTransform
+{
+    float zoom = 1;
+    ImVec2 offset = ImVec2(0, 0);
+
+    CameraTransform() = default;
+
+    /**
+     * @brief Origin is where the view sits on screen,
+     * center is the zoom reference point relative to it.
+     */
+    CameraTransform(
+        const ImVec2 origin,
+        const ImVec2 center,
+        const ImVec2 camera_pan,
+        const float camera_zoom) :
+        zoom(camera_zoom),
+        offset(
+            origin.x + center.x - (camera_pan.x + center.x) * camera_zoom,
+            origin.y + center.y - (camera_pan.y + center.y) * camera_zoom)
+    {
+    }
+
+    ImVec2 WorldToScreen(
+        const ImVec2 world_pos) const
+    {
+        return ImVec2(
+            world_pos.x * zoom + offset.x,
+            world_pos.y * zoom + offset.y);
+    }
+
+    ImVec2 ScreenToWorld(
+        const ImVec2 screen_pos) const
+    {
+        return ImVec2(
+            (screen_pos.x - offset.x) / zoom,
+            (screen_pos.y - offset.y) / zoom);
+    }
+};
+
+/**
+ * @brief out = in * scale + offset over separate x and y arrays,
+ * 8 (AVX), 4 (SSE2, NEON) or 1 point at a time depending on what the
+ * build targets. In and out may be the same arrays.
+ */
+inline void TransformPoints(
+    const float* in_x,
+    const float* in_y,
+    float* out_x,
+    float* out_y,
+    const int count,
+    const float scale,
+    const ImVec2 offset)
+{
+    int ii = 0;
+
+#if defined(LORISE_CAMERA_AVX)
+    const __m256 scale_8 = _mm256_set1_ps(scale);
+    const __m256 offset_x_8 = _mm256_set1_ps(offset.x);
+    const __m256 offset_y_8 = _mm256_set1_ps(offset.y);
+    for (;
+        ii + 8 <= count;
+        ii += 8)
+    {
+        __m256 x = _mm256_loadu_ps(in_x + ii);
+        __m256 y = _mm256_loadu_ps(in_y + ii);
+        _mm256_storeu_ps(out_x + ii, _mm256_add_ps(_mm256_mul_ps(x, scale_8), offset_x_8));
+        _mm256_storeu_ps(out_y + ii, _mm256_add_ps(_mm256_mul_ps(y, scale_8), offset_y_8));
+    }
+#elif defined(LORISE_CAMERA_SSE2)
+    const __m128 scale_4 = _mm_set1_ps(scale);
+    const __m128 offset_x_4 = _mm_set1_ps(offset.x);
+    const __m128 offset_y_4 = _mm_set1_ps(offset.y);
+    for (;
+        ii + 4 <= count;
+        ii += 4)
+    {
+        __m128 x = _mm_loadu_ps(in_x + ii);
+        __m128 y = _mm_loadu_ps(in_y + ii);
+        _mm_storeu_ps(out_x + ii, _mm_add_ps(_mm_mul_ps(x, scale_4), offset_x_4));
+        _mm_storeu_ps(out_y + ii, _mm_add_ps(_mm_mul_ps(y, scale_4), offset_y_4));
+    }
+#elif defined(LORISE_CAMERA_NEON)
+    const float32x4_t scale_4 = vdupq_n_f32(scale);
+    const float32x4_t offset_x_4 = vdupq_n_f32(offset.x);
+    const float32x4_t offset_y_4 = vdupq_n_f32(offset.y);
+    for (;
+        ii + 4 <= count;
+        ii += 4)
+    {
+        // Separate multiply and add, vmlaq_f32 may fuse and round differently from the scalar tail
+        float32x4_t x = vld1q_f32(in_x + ii);
+        float32x4_t y = vld1q_f32(in_y + ii);
+        vst1q_f32(out_x + ii, vaddq_f32(vmulq_f32(x, scale_4), offset_x_4));
+        vst1q_f32(out_y + ii, vaddq_f32(vmulq_f32(y, scale_4), offset_y_4));
+    }
+#endif
+
+    for (;
+        ii < count;
+        ii++)
+    {
+        out_x[ii] = in_x[ii] * scale + offset.x;
+        out_y[ii] = in_y[ii] * scale + offset.y;
+    }
+}
+
+/**
+ * @brief Bulk CameraTransform::WorldToScreen().
+ */
+inline void WorldToScreen(
+    const CameraTransform& camera,
+    const float* world_x,
+    const float* world_y,
+    float* screen_x,
+    float* screen_y,
+    const int count)
+{
+    TransformPoints(
+        world_x,
+        world_y,
+        screen_x,
+        screen_y,
+        count,
+        camera.zoom,
+        camera.offset);
+}
+
+/**
+ * @brief Bulk CameraTransform::ScreenToWorld().
+ * Multiplies by the reciprocal zoom, so results may differ from the
+ * single point version in the last bit.
+ */
+inline void ScreenToWorld(
+    const CameraTransform& camera,
+    const float* screen_x,
+    const float* screen_y,
+    float* world_x,
+    float* world_y,
+    const int count)
+{
+    const float inv_zoom = 1.0f / camera.zoom;
+    TransformPoints(
+        screen_x,
+        screen_y,
+        world_x,
+        world_y,
+        count,
+        inv_zoom,
+        ImVec2(
+            -camera.offset.x * inv_zoom,
+            -camera.offset.y * inv_zoom));
+}
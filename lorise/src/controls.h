@@ -11,7 +11,9 @@
 #include "imgui_impl_opengl3.h"
 
 // Lo-RISE includes
+#include "camera.h"
 #include "interactables.h"
+#include "spatial_index.h"
 #include "utils/utils.h"
 
 /**
@@ -22,23 +24,19 @@ enum Action
     Idle,
     Pan,
     Zoom,
-    DragTactic
+    DragTactic,
+    BoxSelect,
+    DragSelection
 };
 
 /**
- * @brief Return a tactic if one is under the mouse.
+ * @brief Camera of the Lo-RISE view, which covers the display.
  */
-Tactic* GetTacticUnderMouse(
+CameraTransform GetDisplayCamera(
     const ImGuiIO& io,
     const ImVec2 camera_pan,
-    const float camera_zoom,
-    std::vector<Tactic>& tactics)
+    const float camera_zoom)
 {
-    Tactic* ret = NULL;
-    double best_dist_2 = -1;
-
-    ImVec2 mouse_pos = ImGui::GetMousePos();
-    
     // NOTE:
     // Can't use ImGui::GetWindowSize() because 
     // Lo-RISE window hasn't been created yet
@@ -47,45 +45,292 @@ Tactic* GetTacticUnderMouse(
         window_dims.x / 2,
         window_dims.y / 2);
 
-    for (int ii = 0;
-        ii < tactics.size();
-        ii++)
+    return CameraTransform(
+        ImVec2(0, 0),
+        center,
+        camera_pan,
+        camera_zoom);
+}
+
+/**
+ * @brief Return the index of the entity under the mouse, or -1 if none.
+ * Icons are treated as circles of world_radius around entity positions.
+ */
+int GetEntityUnderMouse(
+    const ImGuiIO& io,
+    const ImVec2 camera_pan,
+    const float camera_zoom,
+    const EntityStore& entities,
+    const SpatialIndex& entity_index,
+    const float world_radius)
+{
+    int ret = -1;
+    double best_dist_2 = -1;
+
+    // Picking is done in world space so only the
+    // cells around the mouse need to be visited
+    CameraTransform camera = GetDisplayCamera(
+        io,
+        camera_pan,
+        camera_zoom);
+
+    ImVec2 mouse_pos = camera.ScreenToWorld(ImGui::GetMousePos());
+
+    const float size = world_radius;
+
+    entity_index.QueryRadius(
+        mouse_pos,
+        size,
+        [&](int index)
+        {
+            double dist_2 = Distance(
+                entities.GetPos(index),
+                mouse_pos,
+                true);
+
+            // Ignore if we aren't inside the icon
+            if (dist_2 > size * size)
+            {
+                return;
+            }
+
+            // If icons are overlapping, pick the 
+            // one that is closer to its center
+            if (ret != -1 &&
+                best_dist_2 < dist_2)
+            {
+                return;
+            }
+
+            best_dist_2 = dist_2;
+            ret = index;
+        });
+
+    return ret;
+}
+
+/**
+ * @brief Return the index of the tactic under the mouse, or -1 if none.
+ */
+int GetTacticUnderMouse(
+    const ImGuiIO& io,
+    const ImVec2 camera_pan,
+    const float camera_zoom,
+    const EntityStore& tactics,
+    const SpatialIndex& tactic_index)
+{
+    // Icons scale with zoom, so the world radius is constant
+    return GetEntityUnderMouse(
+        io,
+        camera_pan,
+        camera_zoom,
+        tactics,
+        tactic_index,
+        Tactic::ICON_SIZE);
+}
+
+/**
+ * @brief Return the index of the agent under the mouse, or -1 if none.
+ */
+int GetAgentUnderMouse(
+    const ImGuiIO& io,
+    const ImVec2 camera_pan,
+    const float camera_zoom,
+    const EntityStore& agents,
+    const SpatialIndex& agent_index)
+{
+    // Icons keep their screen size, so the world radius shrinks when zooming in
+    return GetEntityUnderMouse(
+        io,
+        camera_pan,
+        camera_zoom,
+        agents,
+        agent_index,
+        Agent::ICON_SIZE / camera_zoom);
+}
+
+/**
+ * @brief Add the entities inside the world-space rect to the selection.
+ */
+void SelectInRect(
+    const EntityStore& entities,
+    const SpatialIndex& entity_index,
+    const ImVec2 world_min,
+    const ImVec2 world_max,
+    Selection& selection)
+{
+    entity_index.QueryRect(
+        world_min,
+        world_max,
+        [&](int ii)
+        {
+            float x = entities.x[ii];
+            float y = entities.y[ii];
+            if (x >= world_min.x && x <= world_max.x &&
+                y >= world_min.y && y <= world_max.y)
+            {
+                selection.Add(ii);
+            }
+        });
+}
+
+/**
+ * @brief Move every selected entity by the same world offset.
+ */
+void MoveSelected(
+    EntityStore& entities,
+    SpatialIndex& entity_index,
+    const Selection& selection,
+    const ImVec2 offset)
+{
+    selection.ForEach(
+        [&](int index)
+        {
+            ImVec2 pos = ImVec2(
+                entities.x[index] + offset.x,
+                entities.y[index] + offset.y);
+
+            entities.SetPos(
+                index,
+                pos);
+
+            entity_index.Move(
+                index,
+                pos);
+        });
+}
+
+/**
+ * @brief Give every selected entity the same color.
+ */
+void RecolorSelected(
+    EntityStore& entities,
+    const Selection& selection,
+    const ImU32 color)
+{
+    selection.ForEach(
+        [&](int index)
+        {
+            entities.color[index] = color;
+        });
+}
+
+/**
+ * @brief Check if mouse is drawing a selection box over agents.
+ * The box selects on release, replacing the selection unless
+ * ctrl is held to add to it.
+ */
+void BoxSelectAgents(
+    const ImGuiIO& io,
+    const ImVec2 camera_pan,
+    const float camera_zoom,
+    Action& current_action,
+    const EntityStore& agents,
+    const SpatialIndex& agent_index,
+    Selection& selection)
+{
+    // Box select binding, with shift held
+    const ImGuiMouseButton binding = ImGuiMouseButton_Left;
+
+    // Set action if shift is held
+    if (current_action == Action::Idle &&
+        io.KeyShift == true)
     {
-        Tactic tactic = tactics[ii];
+        current_action = Action::BoxSelect;
+    }
+    else if (current_action != Action::BoxSelect)
+    {
+        return;
+    }
 
-        ImVec2 tactic_pos = ImVec2(
-            tactic.pos.x - camera_pan.x,
-            tactic.pos.y - camera_pan.y);
+    if (ImGui::IsMouseReleased(binding) == false)
+    {
+        return;
+    }
 
-        tactic_pos.x = center.x + (tactic_pos.x - center.x) * camera_zoom;
-        tactic_pos.y = center.y + (tactic_pos.y - center.y) * camera_zoom;
+    CameraTransform camera = GetDisplayCamera(
+        io,
+        camera_pan,
+        camera_zoom);
 
-        double dist_2 = Distance(
-            tactic_pos,
-            mouse_pos,
-            true);
+    ImVec2 corner_0 = camera.ScreenToWorld(io.MouseClickedPos[binding]);
+    ImVec2 corner_1 = camera.ScreenToWorld(ImGui::GetMousePos());
 
-        float size = Tactic::ICON_SIZE * camera_zoom;
+    if (io.KeyCtrl == false)
+    {
+        selection.Clear();
+    }
 
-        // Ignore if we aren't inside the icon
-        if (dist_2 > size * size)
+    SelectInRect(
+        agents,
+        agent_index,
+        ImVec2(
+            std::min(corner_0.x, corner_1.x),
+            std::min(corner_0.y, corner_1.y)),
+        ImVec2(
+            std::max(corner_0.x, corner_1.x),
+            std::max(corner_0.y, corner_1.y)),
+        selection);
+}
+
+/**
+ * @brief Check if mouse is trying to drag the selected agents,
+ * by grabbing any one of them.
+ */
+void DragSelectedAgents(
+    const ImGuiIO& io,
+    const ImVec2 camera_pan,
+    const float camera_zoom,
+    Action& current_action,
+    EntityStore& agents,
+    SpatialIndex& agent_index,
+    const Selection& selection)
+{
+    // Selection drag binding
+    const ImGuiMouseButton binding = ImGuiMouseButton_Left;
+
+    // Only start on a selected agent
+    if (current_action == Action::Idle)
+    {
+        if (selection.Empty() == true)
         {
-            continue;
+            return;
         }
 
-        // If icons are overlapping, pick the 
-        // one that is closer to its center
-        if (ret != NULL &&
-            best_dist_2 < dist_2)
+        int agent = GetAgentUnderMouse(
+            io,
+            camera_pan,
+            camera_zoom,
+            agents,
+            agent_index);
+
+        if (agent == -1 ||
+            selection.Contains(agent) == false)
         {
-            continue;
+            return;
         }
 
-        best_dist_2 = dist_2;
-        ret = &tactics[ii];
+        current_action = Action::DragSelection;
+    }
+    else if (current_action != Action::DragSelection)
+    {
+        return;
     }
 
-    return ret;
+    // Apply drag to every selected agent on release,
+    // a click without dragging moves nothing
+    ImVec2 drag = ImGui::GetMouseDragDelta(binding);
+    if (ImGui::IsMouseReleased(binding) == true &&
+        (drag.x != 0 || drag.y != 0))
+    {
+        MoveSelected(
+            agents,
+            agent_index,
+            selection,
+            ImVec2(
+                drag.x / camera_zoom,
+                drag.y / camera_zoom));
+    }
 }
 
 /**
@@ -96,8 +341,9 @@ void DragTacticIcon(
     const ImVec2 camera_pan,
     const float camera_zoom,
     Action& current_action,
-    std::vector<Tactic>& tactics,
-    Tactic*& selected_tactic)
+    EntityStore& tactics,
+    SpatialIndex& tactic_index,
+    EntityHandle& selected_tactic)
 {
     // Tactic icon drag binding
     const ImGuiMouseButton binding = ImGuiMouseButton_Left;
@@ -109,15 +355,30 @@ void DragTacticIcon(
         return;
     }
 
+    // A tactic removed mid-drag leaves the drag with nothing to move
+    int tactic = tactics.Find(selected_tactic);
+    if (tactic == -1 &&
+        current_action == Action::DragTactic)
+    {
+        return;
+    }
+
     // Nothing to do if no tactic
-    selected_tactic = selected_tactic ?: 
-        GetTacticUnderMouse(
+    if (tactic == -1)
+    {
+        tactic = GetTacticUnderMouse(
             io,
             camera_pan,
             camera_zoom,
-            tactics);
+            tactics,
+            tactic_index);
+
+        selected_tactic = tactic == -1 ?
+            EntityHandle() :
+            tactics.GetHandle(tactic);
+    }
 
-    if (selected_tactic == NULL)
+    if (tactic == -1)
     {
         current_action = Action::Idle;
         return;
@@ -137,8 +398,17 @@ void DragTacticIcon(
     if (ImGui::IsMouseReleased(binding) == true)
     {
         ImVec2 drag = ImGui::GetMouseDragDelta(binding);
-        selected_tactic->pos.x += (drag.x / camera_zoom);
-        selected_tactic->pos.y += (drag.y / camera_zoom);
+        ImVec2 pos = tactics.GetPos(tactic);
+        pos.x += (drag.x / camera_zoom);
+        pos.y += (drag.y / camera_zoom);
+
+        tactics.SetPos(
+            tactic,
+            pos);
+
+        tactic_index.Move(
+            tactic,
+            pos);
     }
 }
 
@@ -223,7 +493,7 @@ float ZoomCamera(
         1 - (drag.y / (2 * sensitivity));
 
     const float max_zoom = 2;
-    const float min_zoom = 0.5;
+    const float min_zoom = 0.1;
     zoom = std::max(
         min_zoom / camera_zoom,
         std::min(
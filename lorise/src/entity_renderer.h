@@ -0,0 +1,758 @@
+#pragma once
+
+// Standard library includes
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// ImGui includes
+#include "imgui.h"
+#include "imgui_internal.h"
+
+// Lo-RISE includes
+#include "entity_store.h"
+#include "icon_atlas.h"
+#include "interactables.h"
+#include "world_update.h"
+
+/**
+ * @brief How much of an entity gets drawn.
+ */
+enum DetailLevel
+{
+    Full,       // Icon and label
+    IconOnly,   // Icon without label
+    Point       // Single pixel
+};
+
+/**
+ * @brief Closed outline centered on the origin, with the miter
+ * normals used to build its anti-aliased fringe.
+ */
+struct OutlineShape
+{
+    std::vector<ImVec2> points;
+    std::vector<ImVec2> normals;
+    float radius = 0;
+};
+
+/**
+ * @brief Precompute the outline of a regular polygon, matching
+ * the points ImDrawList::AddNgon()/AddCircle() would generate.
+ */
+void BuildOutlineShape(
+    OutlineShape& shape,
+    const float radius,
+    const int num_segments)
+{
+    shape.radius = radius;
+    shape.points.resize(num_segments);
+    shape.normals.resize(num_segments);
+
+    for (int ii = 0;
+        ii < num_segments;
+        ii++)
+    {
+        float a = (IM_PI * 2.0f) * (float)ii / (float)num_segments;
+        shape.points[ii] = ImVec2(
+            std::cos(a) * (radius - 0.5f),
+            std::sin(a) * (radius - 0.5f));
+    }
+
+    // Average the normals of both adjoining edges,
+    // same as ImDrawList::AddPolyline() does for thin lines
+    for (int ii = 0;
+        ii < num_segments;
+        ii++)
+    {
+        int prev = (ii + num_segments - 1) % num_segments;
+        int next = (ii + 1) % num_segments;
+
+        ImVec2 d0 = ImVec2(
+            shape.points[ii].x - shape.points[prev].x,
+            shape.points[ii].y - shape.points[prev].y);
+
+        ImVec2 d1 = ImVec2(
+            shape.points[next].x - shape.points[ii].x,
+            shape.points[next].y - shape.points[ii].y);
+
+        float inv_len_0 = ImInvLength(d0, 1.0f);
+        float inv_len_1 = ImInvLength(d1, 1.0f);
+
+        ImVec2 dm = ImVec2(
+            (d0.y * inv_len_0 + d1.y * inv_len_1) * 0.5f,
+            -(d0.x * inv_len_0 + d1.x * inv_len_1) * 0.5f);
+
+        float d2 = dm.x * dm.x + dm.y * dm.y;
+        if (d2 > 0.000001f)
+        {
+            float inv_len_2 = ImMin(1.0f / d2, 100.0f);
+            dm.x *= inv_len_2;
+            dm.y *= inv_len_2;
+        }
+
+        shape.normals[ii] = dm;
+    }
+}
+
+/**
+ * @brief Write an anti-aliased 1px outline into space already
+ * reserved with PrimReserve(). Uses 3 vertices and 12 indices per point.
+ */
+void WriteOutline(
+    ImDrawList* draw_list,
+    const OutlineShape& shape,
+    const ImVec2 center,
+    const ImU32 color)
+{
+    const ImVec2 uv = draw_list->_Data->TexUvWhitePixel;
+    const ImU32 color_trans = color & ~IM_COL32_A_MASK;
+    const float fringe = draw_list->_FringeScale;
+    const int count = (int)shape.points.size();
+    const unsigned int idx_base = draw_list->_VtxCurrentIdx;
+
+    for (int ii = 0;
+        ii < count;
+        ii++)
+    {
+        float x = center.x + shape.points[ii].x;
+        float y = center.y + shape.points[ii].y;
+        float nx = shape.normals[ii].x * fringe;
+        float ny = shape.normals[ii].y * fringe;
+        draw_list->PrimWriteVtx(ImVec2(x, y), uv, color);
+        draw_list->PrimWriteVtx(ImVec2(x + nx, y + ny), uv, color_trans);
+        draw_list->PrimWriteVtx(ImVec2(x - nx, y - ny), uv, color_trans);
+    }
+
+    for (int ii = 0;
+        ii < count;
+        ii++)
+    {
+        ImDrawIdx idx1 = (ImDrawIdx)(idx_base + ii * 3);
+        ImDrawIdx idx2 = (ImDrawIdx)(idx_base + ((ii + 1) % count) * 3);
+        draw_list->PrimWriteIdx(idx2 + 0);
+        draw_list->PrimWriteIdx(idx1 + 0);
+        draw_list->PrimWriteIdx(idx1 + 2);
+        draw_list->PrimWriteIdx(idx1 + 2);
+        draw_list->PrimWriteIdx(idx2 + 2);
+        draw_list->PrimWriteIdx(idx2 + 0);
+        draw_list->PrimWriteIdx(idx2 + 1);
+        draw_list->PrimWriteIdx(idx1 + 1);
+        draw_list->PrimWriteIdx(idx1 + 0);
+        draw_list->PrimWriteIdx(idx1 + 0);
+        draw_list->PrimWriteIdx(idx2 + 0);
+        draw_list->PrimWriteIdx(idx2 + 1);
+    }
+}
+
+/**
+ * @brief Write an atlas icon centered on center as one quad into space
+ * already reserved with PrimReserve(). Uses 4 vertices and 6 indices.
+ */
+void WriteIcon(
+    ImDrawList* draw_list,
+    const IconRect& icon,
+    const ImVec2 center,
+    const ImU32 color)
+{
+    const float half = icon.size * 0.5f;
+    draw_list->PrimRectUV(
+        ImVec2(center.x - half, center.y - half),
+        ImVec2(center.x + half, center.y + half),
+        icon.uv_min,
+        icon.uv_max,
+        color);
+}
+
+/**
+ * @brief Text sizes of an entity store's names, measured once per
+ * distinct name. Entities sharing a name share the entry, and renaming
+ * an entity gives it a new name handle so nothing goes stale. Everything
+ * is measured again when the font or its size changes.
+ */
+struct TextExtentCache
+{
+    const ImFont* font = NULL;
+    float font_size = 0;
+    std::vector<ImVec2> sizes;      // By NameHandle, negative x until measured
+
+    ImVec2 Get(
+        const EntityStore& store,
+        const int index,
+        ImFont* current_font,
+        const float current_font_size)
+    {
+        if (current_font != font ||
+            current_font_size != font_size)
+        {
+            font = current_font;
+            font_size = current_font_size;
+            sizes.clear();
+        }
+
+        NameHandle handle = store.name[index];
+        if (handle >= sizes.size())
+        {
+            sizes.resize(
+                store.names.names.size(),
+                ImVec2(-1, -1));
+        }
+
+        ImVec2& size = sizes[handle];
+        if (size.x < 0)
+        {
+            size = current_font->CalcTextSizeA(
+                current_font_size,
+                FLT_MAX,
+                0.0f,
+                store.names.Get(handle));
+        }
+
+        return size;
+    }
+};
+
+/**
+ * @brief Coarse screen occupancy for greedy label placement. Labels are
+ * claimed in draw order; one overlapping an earlier label is hidden.
+ * Cells are CELL_SIZE pixels, so labels count as the cells they touch.
+ */
+struct LabelGrid
+{
+    static const int CELL_SIZE = 8;
+
+    ImVec2 origin = ImVec2(0, 0);
+    int columns = 0;
+    int rows = 0;
+    std::vector<uint8_t> cells;     // Row-major, 1 if taken
+
+    /**
+     * @brief Free every cell and cover a view of the given size.
+     */
+    void Reset(
+        const ImVec2 view_origin,
+        const ImVec2 view_size)
+    {
+        origin = view_origin;
+        columns = std::max((int)std::ceil(view_size.x / CELL_SIZE), 1);
+        rows = std::max((int)std::ceil(view_size.y / CELL_SIZE), 1);
+        cells.assign(
+            (size_t)columns * rows,
+            0);
+    }
+
+    /**
+     * @brief Take the cells under a screen rect if they are all free.
+     * Returns false, taking nothing, if any is taken or the rect is
+     * entirely outside the view.
+     */
+    bool Claim(
+        const ImVec2 min,
+        const ImVec2 max)
+    {
+        int c0 = std::max((int)std::floor((min.x - origin.x) / CELL_SIZE), 0);
+        int r0 = std::max((int)std::floor((min.y - origin.y) / CELL_SIZE), 0);
+        int c1 = std::min((int)std::floor((max.x - origin.x) / CELL_SIZE), columns - 1);
+        int r1 = std::min((int)std::floor((max.y - origin.y) / CELL_SIZE), rows - 1);
+        if (c0 > c1 ||
+            r0 > r1)
+        {
+            return false;
+        }
+
+        for (int rr = r0;
+            rr <= r1;
+            rr++)
+        {
+            for (int cc = c0;
+                cc <= c1;
+                cc++)
+            {
+                if (cells[(size_t)rr * columns + cc] != 0)
+                {
+                    return false;
+                }
+            }
+        }
+
+        for (int rr = r0;
+            rr <= r1;
+            rr++)
+        {
+            std::fill(
+                cells.begin() + (size_t)rr * columns + c0,
+                cells.begin() + (size_t)rr * columns + c1 + 1,
+                1);
+        }
+
+        return true;
+    }
+};
+
+/**
+ * @brief Draws entities straight into a draw list, bypassing widget
+ * submission. Icons are written into reserved primitive space and
+ * labels are rendered with the current font.
+ *
+ * Agent icons are quads from the icon atlas when it was built into the
+ * font atlas the draw list is using, and tessellated outlines otherwise.
+ * Tactics stay outlines, their radius follows the zoom while the line
+ * stays 1px wide, which a scaled texture can't do.
+ */
+struct EntityRenderer
+{
+    OutlineShape air_shape;         // Air agent triangle
+    OutlineShape ground_shape;      // Ground agent square
+    OutlineShape tactic_shape;      // Tactic circle, rebuilt when zoom changes
+    OutlineShape selection_shape;   // Ring around selected agents
+    TextExtentCache agent_labels;   // Agent name sizes
+    TextExtentCache tactic_labels;  // Tactic name sizes
+    LabelGrid label_grid;           // Screen space taken by labels this frame
+
+    static const ImU32 SELECTION_COLOR = IM_COL32(255, 255, 0, 255);
+    static const ImU32 SELECTION_FILL_COLOR = IM_COL32(255, 255, 0, 30);
+
+    /**
+     * @brief Most entities whose geometry can be reserved at once.
+     * With 16-bit indices a reservation must fit a single index range.
+     */
+    static int ChunkSize(
+        const int vtx_per_entity)
+    {
+        return sizeof(ImDrawIdx) == 2 ?
+            ((1 << 16) - 1) / vtx_per_entity :
+            (1 << 24) / vtx_per_entity;
+    }
+
+    /**
+     * @brief Start a frame of labels over a view. Labels drawn after
+     * this that overlap an earlier one are hidden.
+     */
+    void BeginLabels(
+        const ImVec2 view_origin,
+        const ImVec2 view_size)
+    {
+        label_grid.Reset(
+            view_origin,
+            view_size);
+    }
+
+    /**
+     * @brief Draw the given agents at the given level of detail,
+     * at their positions in screen. Selected agents are highlighted
+     * and offset by selection_drag.
+     */
+    void DrawAgents(
+        ImDrawList* draw_list,
+        const ScreenPositions& screen,
+        const EntityStore& agents,
+        const std::vector<int>& visible,
+        const Selection& selection,
+        const ImVec2 selection_drag,
+        const DetailLevel detail)
+    {
+        if (ground_shape.points.empty() == true)
+        {
+            BuildOutlineShape(air_shape, Agent::ICON_SIZE, 3);
+            BuildOutlineShape(ground_shape, Agent::ICON_SIZE, 4);
+            BuildOutlineShape(selection_shape, Agent::ICON_SIZE + 4, 12);
+        }
+
+        const int count = (int)visible.size();
+        const ImVec2 uv = draw_list->_Data->TexUvWhitePixel;
+        const bool any_selected = selection.Empty() == false;
+
+        auto position = [&](int index) -> ImVec2
+        {
+            ImVec2 pos = screen.Get(index);
+            if (any_selected == true &&
+                selection.Contains(index) == true)
+            {
+                pos.x += selection_drag.x;
+                pos.y += selection_drag.y;
+            }
+            return pos;
+        };
+
+        // Points are plain quads
+        if (detail == DetailLevel::Point)
+        {
+            const int chunk_size = ChunkSize(4);
+            for (int start = 0;
+                start < count;
+                start += chunk_size)
+            {
+                int end = std::min(start + chunk_size, count);
+                draw_list->PrimReserve(
+                    (end - start) * 6,
+                    (end - start) * 4);
+
+                for (int ii = start;
+                    ii < end;
+                    ii++)
+                {
+                    int index = visible[ii];
+                    ImVec2 pos = position(index);
+
+                    // Too small for a ring, selected points change color instead
+                    draw_list->PrimRectUV(
+                        pos,
+                        ImVec2(pos.x + 1, pos.y + 1),
+                        uv,
+                        uv,
+                        any_selected == true && selection.Contains(index) == true ?
+                            SELECTION_COLOR :
+                            agents.color[index]);
+                }
+            }
+            return;
+        }
+
+        const IconAtlasData& icon_atlas = GetIconAtlas();
+        if (icon_atlas.ready == true &&
+            draw_list->_CmdHeader.TextureId == icon_atlas.atlas->TexID)
+        {
+            DrawAgentIcons(
+                draw_list,
+                icon_atlas,
+                agents,
+                visible,
+                selection,
+                position);
+        }
+        else
+        {
+            DrawAgentOutlines(
+                draw_list,
+                agents,
+                visible,
+                selection,
+                position);
+        }
+
+        if (detail != DetailLevel::Full)
+        {
+            return;
+        }
+
+        // Name needs to be centered below the agent
+        ImFont* font = ImGui::GetFont();
+        const float font_size = ImGui::GetFontSize();
+        const ImVec4 clip_rect = draw_list->_CmdHeader.ClipRect;
+        for (int index : visible)
+        {
+            ImVec2 pos = position(index);
+            ImVec2 text_dims = agent_labels.Get(
+                agents,
+                index,
+                font,
+                font_size);
+
+            ImVec2 text_pos = ImVec2(
+                pos.x - (text_dims.x / 2),
+                pos.y - (text_dims.y / 2) + (Agent::ICON_SIZE * 2));
+
+            if (label_grid.Claim(
+                text_pos,
+                ImVec2(
+                    text_pos.x + text_dims.x,
+                    text_pos.y + text_dims.y)) == false)
+            {
+                continue;
+            }
+
+            const char* name = agents.GetName(index);
+            font->RenderText(
+                draw_list,
+                font_size,
+                text_pos,
+                agents.color[index],
+                clip_rect,
+                name,
+                NULL);
+        }
+    }
+
+    /**
+     * @brief Draw the given tactics. The dragged tactic, if any,
+     * is offset by the drag instead of sitting at its position in screen.
+     */
+    void DrawTactics(
+        ImDrawList* draw_list,
+        const ScreenPositions& screen,
+        const float camera_zoom,
+        const EntityStore& tactics,
+        const std::vector<int>& visible,
+        const int dragged_tactic,
+        const ImVec2 drag,
+        const DetailLevel detail)
+    {
+        const float radius = Tactic::ICON_SIZE * camera_zoom;
+        if (radius < 0.5f)
+        {
+            return;
+        }
+
+        if (tactic_shape.radius != radius)
+        {
+            BuildOutlineShape(
+                tactic_shape,
+                radius,
+                draw_list->_CalcCircleAutoSegmentCount(radius));
+        }
+
+        const int count = (int)visible.size();
+        const int points = (int)tactic_shape.points.size();
+        const int chunk_size = ChunkSize(points * 3);
+        for (int start = 0;
+            start < count;
+            start += chunk_size)
+        {
+            int end = std::min(start + chunk_size, count);
+            draw_list->PrimReserve(
+                (end - start) * points * 12,
+                (end - start) * points * 3);
+
+            for (int ii = start;
+                ii < end;
+                ii++)
+            {
+                int index = visible[ii];
+                ImVec2 pos = screen.Get(index);
+
+                if (index == dragged_tactic)
+                {
+                    pos.x += drag.x;
+                    pos.y += drag.y;
+                }
+
+                WriteOutline(
+                    draw_list,
+                    tactic_shape,
+                    pos,
+                    tactics.color[index]);
+            }
+        }
+
+        if (detail != DetailLevel::Full)
+        {
+            return;
+        }
+
+        // Name needs to be centered on the tactic
+        ImFont* font = ImGui::GetFont();
+        const float font_size = ImGui::GetFontSize();
+        const ImVec4 clip_rect = draw_list->_CmdHeader.ClipRect;
+        for (int index : visible)
+        {
+            ImVec2 pos = screen.Get(index);
+
+            if (index == dragged_tactic)
+            {
+                pos.x += drag.x;
+                pos.y += drag.y;
+            }
+
+            ImVec2 text_dims = tactic_labels.Get(
+                tactics,
+                index,
+                font,
+                font_size);
+
+            ImVec2 text_pos = ImVec2(
+                pos.x - (text_dims.x / 2),
+                pos.y - (text_dims.y / 2));
+
+            if (label_grid.Claim(
+                text_pos,
+                ImVec2(
+                    text_pos.x + text_dims.x,
+                    text_pos.y + text_dims.y)) == false)
+            {
+                continue;
+            }
+
+            const char* name = tactics.GetName(index);
+            font->RenderText(
+                draw_list,
+                font_size,
+                text_pos,
+                tactics.color[index],
+                clip_rect,
+                name,
+                NULL);
+        }
+    }
+
+    /**
+     * @brief Agent icons and selection rings as tessellated outlines.
+     */
+    template <typename Position>
+    void DrawAgentOutlines(
+        ImDrawList* draw_list,
+        const EntityStore& agents,
+        const std::vector<int>& visible,
+        const Selection& selection,
+        const Position& position)
+    {
+        const int count = (int)visible.size();
+        const bool any_selected = selection.Empty() == false;
+
+        // Reserve for the larger shape and give back what
+        // triangles didn't use at the end of each chunk
+        const int max_points = (int)ground_shape.points.size();
+        const int chunk_size = ChunkSize(max_points * 3);
+        for (int start = 0;
+            start < count;
+            start += chunk_size)
+        {
+            int end = std::min(start + chunk_size, count);
+            int reserved_points = (end - start) * max_points;
+            int written_points = 0;
+
+            draw_list->PrimReserve(
+                reserved_points * 12,
+                reserved_points * 3);
+
+            for (int ii = start;
+                ii < end;
+                ii++)
+            {
+                int index = visible[ii];
+                ImVec2 pos = position(index);
+
+                const OutlineShape& shape = agents.GetFlag(index, EntityStore::Air) ?
+                    air_shape :
+                    ground_shape;
+
+                WriteOutline(
+                    draw_list,
+                    shape,
+                    pos,
+                    agents.color[index]);
+
+                written_points += (int)shape.points.size();
+            }
+
+            draw_list->PrimUnreserve(
+                (reserved_points - written_points) * 12,
+                (reserved_points - written_points) * 3);
+        }
+
+        // Rings around the selected ones, reserving as if all were selected
+        const int ring_points = (int)selection_shape.points.size();
+        const int ring_chunk_size = ChunkSize(ring_points * 3);
+        for (int start = 0;
+            start < count && any_selected == true;
+            start += ring_chunk_size)
+        {
+            int end = std::min(start + ring_chunk_size, count);
+            int unused = 0;
+
+            draw_list->PrimReserve(
+                (end - start) * ring_points * 12,
+                (end - start) * ring_points * 3);
+
+            for (int ii = start;
+                ii < end;
+                ii++)
+            {
+                int index = visible[ii];
+                if (selection.Contains(index) == false)
+                {
+                    unused++;
+                    continue;
+                }
+
+                WriteOutline(
+                    draw_list,
+                    selection_shape,
+                    position(index),
+                    SELECTION_COLOR);
+            }
+
+            draw_list->PrimUnreserve(
+                unused * ring_points * 12,
+                unused * ring_points * 3);
+        }
+    }
+
+    /**
+     * @brief Agent icons and selection rings as atlas quads.
+     */
+    template <typename Position>
+    void DrawAgentIcons(
+        ImDrawList* draw_list,
+        const IconAtlasData& icon_atlas,
+        const EntityStore& agents,
+        const std::vector<int>& visible,
+        const Selection& selection,
+        const Position& position)
+    {
+        const int count = (int)visible.size();
+        const bool any_selected = selection.Empty() == false;
+        const IconRect& air_icon = icon_atlas.icons[IconAirAgent];
+        const IconRect& ground_icon = icon_atlas.icons[IconGroundAgent];
+        const IconRect& selection_icon = icon_atlas.icons[IconSelection];
+
+        const int chunk_size = ChunkSize(4);
+        for (int start = 0;
+            start < count;
+            start += chunk_size)
+        {
+            int end = std::min(start + chunk_size, count);
+            draw_list->PrimReserve(
+                (end - start) * 6,
+                (end - start) * 4);
+
+            for (int ii = start;
+                ii < end;
+                ii++)
+            {
+                int index = visible[ii];
+                WriteIcon(
+                    draw_list,
+                    agents.GetFlag(index, EntityStore::Air) ?
+                        air_icon :
+                        ground_icon,
+                    position(index),
+                    agents.color[index]);
+            }
+        }
+
+        // Rings around the selected ones, reserving as if all were selected
+        for (int start = 0;
+            start < count && any_selected == true;
+            start += chunk_size)
+        {
+            int end = std::min(start + chunk_size, count);
+            int unused = 0;
+
+            draw_list->PrimReserve(
+                (end - start) * 6,
+                (end - start) * 4);
+
+            for (int ii = start;
+                ii < end;
+                ii++)
+            {
+                int index = visible[ii];
+                if (selection.Contains(index) == false)
+                {
+                    unused++;
+                    continue;
+                }
+
+                WriteIcon(
+                    draw_list,
+                    selection_icon,
+                    position(index),
+                    SELECTION_COLOR);
+            }
+
+            draw_list->PrimUnreserve(
+                unused * 6,
+                unused * 4);
+        }
+    }
+};
@@ -0,0 +1,409 @@
+#pragma once
+
+// Standard library includes
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// ImGui includes
+#include "imgui.h"
+
+/**
+ * @brief Handle to an interned name. Stable for the lifetime of its table.
+ */
+typedef uint32_t NameHandle;
+
+/**
+ * @brief Interned entity names. Each distinct string is stored once
+ * so entities only carry a small handle instead of a std::string.
+ */
+struct NameTable
+{
+    std::vector<std::string> names;                         // Handle -> string
+    std::unordered_map<std::string, NameHandle> lookup;     // String -> handle
+
+    /**
+     * @brief Return the handle for a name, adding it if new.
+     */
+    NameHandle Intern(
+        const std::string& name)
+    {
+        auto it = lookup.find(name);
+        if (it != lookup.end())
+        {
+            return it->second;
+        }
+
+        NameHandle handle = (NameHandle)names.size();
+        names.push_back(name);
+        lookup.emplace(
+            name,
+            handle);
+
+        return handle;
+    }
+
+    /**
+     * @brief Get the string of an interned name.
+     */
+    const char* Get(
+        const NameHandle handle) const
+    {
+        return names[handle].c_str();
+    }
+};
+
+/**
+ * @brief Stable reference to an entity. The index is the entity's slot
+ * in its store, the generation tells apart entities that have since
+ * reused the slot. Compares in O(1) and never dangles: a handle to a
+ * removed entity just stops resolving.
+ */
+struct EntityHandle
+{
+    static const uint32_t NONE = 0xFFFFFFFF;
+
+    uint32_t index = NONE;
+    uint32_t generation = 0;
+
+    bool operator==(
+        const EntityHandle& other) const
+    {
+        return index == other.index &&
+            generation == other.generation;
+    }
+
+    bool operator!=(
+        const EntityHandle& other) const
+    {
+        return (*this == other) == false;
+    }
+};
+
+/**
+ * @brief Structure-of-arrays storage for entities.
+ * Hot per-entity fields are kept in separate contiguous arrays
+ * so per-frame loops stream through tightly packed memory.
+ *
+ * Entities are addressed by index everywhere per-frame, and indices
+ * never move: removing an entity leaves its slot flagged Removed until
+ * Insert() reuses it, so anything keyed by index stays valid. Holders
+ * of long-lived references keep an EntityHandle and Find() it instead.
+ */
+struct EntityStore
+{
+    /**
+     * @brief Boolean entity attributes, each stored as a bitset.
+     */
+    enum Flag
+    {
+        Air,
+        Dead,
+        Removed,                                // Free slot, skipped by the spatial index
+        FlagCount
+    };
+
+    std::vector<float> x;                       // World x-position
+    std::vector<float> y;                       // World y-position
+    std::vector<ImU32> color;                   // Icon and label color
+    std::vector<NameHandle> name;               // Handle into names
+    std::vector<uint64_t> flags[FlagCount];     // One bit per entity, per flag
+    std::vector<uint32_t> generation;           // Bumped each time the slot is freed
+    std::vector<int> free_slots;                // Removed slots, reused last in first out
+    NameTable names;
+
+    int Size() const
+    {
+        return (int)x.size();
+    }
+
+    /**
+     * @brief Preallocate storage so adding entities won't reallocate.
+     */
+    void Reserve(
+        const int count)
+    {
+        x.reserve(count);
+        y.reserve(count);
+        color.reserve(count);
+        name.reserve(count);
+        generation.reserve(count);
+
+        for (int ff = 0;
+            ff < FlagCount;
+            ff++)
+        {
+            flags[ff].reserve((count + 63) / 64);
+        }
+    }
+
+    /**
+     * @brief Append an entity and return its index.
+     */
+    int Add(
+        const std::string& entity_name,
+        const ImVec2 pos,
+        const ImU32 entity_color)
+    {
+        int index = Size();
+
+        x.push_back(pos.x);
+        y.push_back(pos.y);
+        color.push_back(entity_color);
+        name.push_back(names.Intern(entity_name));
+        generation.push_back(0);
+
+        if (index % 64 == 0)
+        {
+            for (int ff = 0;
+                ff < FlagCount;
+                ff++)
+            {
+                flags[ff].push_back(0);
+            }
+        }
+
+        return index;
+    }
+
+    /**
+     * @brief Add an entity, reusing a removed slot if there is one.
+     * Returns its handle; the slot is handle.index.
+     */
+    EntityHandle Insert(
+        const std::string& entity_name,
+        const ImVec2 pos,
+        const ImU32 entity_color)
+    {
+        if (free_slots.empty() == true)
+        {
+            return GetHandle(Add(
+                entity_name,
+                pos,
+                entity_color));
+        }
+
+        int index = free_slots.back();
+        free_slots.pop_back();
+
+        SetPos(index, pos);
+        color[index] = entity_color;
+        name[index] = names.Intern(entity_name);
+        for (int ff = 0;
+            ff < FlagCount;
+            ff++)
+        {
+            SetFlag(index, (Flag)ff, false);
+        }
+
+        return GetHandle(index);
+    }
+
+    /**
+     * @brief Free an entity's slot. Its handles stop resolving.
+     * Returns false if the handle was already stale.
+     */
+    bool Remove(
+        const EntityHandle handle)
+    {
+        int index = Find(handle);
+        if (index == -1)
+        {
+            return false;
+        }
+
+        SetFlag(index, Removed, true);
+        generation[index]++;
+        free_slots.push_back(index);
+        return true;
+    }
+
+    bool IsLive(
+        const int index) const
+    {
+        return index >= 0 &&
+            index < Size() &&
+            GetFlag(index, Removed) == false;
+    }
+
+    EntityHandle GetHandle(
+        const int index) const
+    {
+        EntityHandle handle;
+        handle.index = (uint32_t)index;
+        handle.generation = generation[index];
+        return handle;
+    }
+
+    /**
+     * @brief Index of the entity a handle refers to, or -1 if it was removed.
+     */
+    int Find(
+        const EntityHandle handle) const
+    {
+        if (handle.index >= (uint32_t)Size() ||
+            generation[handle.index] != handle.generation ||
+            GetFlag((int)handle.index, Removed) == true)
+        {
+            return -1;
+        }
+
+        return (int)handle.index;
+    }
+
+    ImVec2 GetPos(
+        const int index) const
+    {
+        return ImVec2(
+            x[index],
+            y[index]);
+    }
+
+    void SetPos(
+        const int index,
+        const ImVec2 pos)
+    {
+        x[index] = pos.x;
+        y[index] = pos.y;
+    }
+
+    bool GetFlag(
+        const int index,
+        const Flag flag) const
+    {
+        return (flags[flag][index / 64] >> (index % 64)) & 1;
+    }
+
+    void SetFlag(
+        const int index,
+        const Flag flag,
+        const bool value)
+    {
+        uint64_t mask = (uint64_t)1 << (index % 64);
+        uint64_t& word = flags[flag][index / 64];
+        word = value ?
+            word | mask :
+            word & ~mask;
+    }
+
+    const char* GetName(
+        const int index) const
+    {
+        return names.Get(name[index]);
+    }
+
+    /**
+     * @brief Rename an entity. Anything cached by name handle,
+     * like label sizes, follows since the handle changes with it.
+     */
+    void SetName(
+        const int index,
+        const std::string& entity_name)
+    {
+        name[index] = names.Intern(entity_name);
+    }
+};
+
+/**
+ * @brief Index of the lowest set bit of a non-zero word.
+ */
+inline int CountTrailingZeros(
+    const uint64_t word)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (int)index;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+/**
+ * @brief Set of entity indices, one bit per entity. Grows as entities
+ * are added to it, indices past the end count as not selected.
+ */
+struct Selection
+{
+    std::vector<uint64_t> bits;
+    int count = 0;
+
+    bool Empty() const
+    {
+        return count == 0;
+    }
+
+    bool Contains(
+        const int index) const
+    {
+        return index / 64 < (int)bits.size() &&
+            ((bits[index / 64] >> (index % 64)) & 1) != 0;
+    }
+
+    void Remove(
+        const int index)
+    {
+        if (Contains(index) == true)
+        {
+            bits[index / 64] &= ~((uint64_t)1 << (index % 64));
+            count--;
+        }
+    }
+
+    void Add(
+        const int index)
+    {
+        if (index / 64 >= (int)bits.size())
+        {
+            bits.resize(index / 64 + 1, 0);
+        }
+
+        uint64_t mask = (uint64_t)1 << (index % 64);
+        uint64_t& word = bits[index / 64];
+        if ((word & mask) == 0)
+        {
+            word |= mask;
+            count++;
+        }
+    }
+
+    /**
+     * @brief Deselect everything, keeping the storage.
+     */
+    void Clear()
+    {
+        std::fill(
+            bits.begin(),
+            bits.end(),
+            0);
+
+        count = 0;
+    }
+
+    /**
+     * @brief Call visit(index) for every selected index, in order.
+     * Skips empty words, so sparse selections are cheap to walk.
+     */
+    template <typename Visitor>
+    void ForEach(
+        Visitor&& visit) const
+    {
+        for (int ww = 0;
+            ww < (int)bits.size();
+            ww++)
+        {
+            uint64_t word = bits[ww];
+            while (word != 0)
+            {
+                visit(ww * 64 + CountTrailingZeros(word));
+                word &= word - 1;
+            }
+        }
+    }
+};
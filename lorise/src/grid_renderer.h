@@ -0,0 +1,291 @@
+#pragma once
+
+// Standard library includes
+#include <stdio.h>
+#include <string.h>
+
+// ImGui includes
+#include "imgui.h"
+#include "imgui_impl_opengl3.h"
+
+// Lo-RISE includes
+#include "lorise.h"
+#include "utils/gl_procs.h"
+
+/**
+ * @brief GL objects owned by the GPU grid.
+ */
+struct GridRendererData
+{
+    GLuint program = 0;
+    GLint loc_display_pos = -1;
+    GLint loc_framebuffer_scale = -1;
+    GLint loc_framebuffer_height = -1;
+    GLint loc_origin = -1;
+    GLint loc_center = -1;
+    GLint loc_camera_pan = -1;
+    GLint loc_camera_zoom = -1;
+    GLint loc_cell_size = -1;
+    GLint loc_major_every = -1;
+    GLint loc_minor_color = -1;
+    GLint loc_major_color = -1;
+};
+
+GridRendererData& GetGridRendererData()
+{
+    static GridRendererData data;
+    return data;
+}
+
+/**
+ * @brief Compile one stage of the grid shader, printing the log on failure.
+ */
+GLuint CompileGridShader(
+    const GLenum type,
+    const char* glsl_version,
+    const char* source)
+{
+    GLProcs& gl = GetGLProcs();
+
+    const char* sources[] = {
+        glsl_version,
+        "\n",
+        source };
+
+    GLuint shader = gl.CreateShader(type);
+    gl.ShaderSource(
+        shader,
+        3,
+        sources,
+        NULL);
+
+    gl.CompileShader(shader);
+
+    GLint status = 0;
+    gl.GetShaderiv(
+        shader,
+        GL_COMPILE_STATUS,
+        &status);
+
+    if (status == GL_FALSE)
+    {
+        char log[1024];
+        gl.GetShaderInfoLog(
+            shader,
+            sizeof(log),
+            NULL,
+            log);
+
+        fprintf(stderr, "Lo-RISE: grid shader failed to compile:\n%s\n", log);
+        gl.DeleteShader(shader);
+        return 0;
+    }
+
+    return shader;
+}
+
+/**
+ * @brief Build the procedural grid shader. Call after ImGui_ImplOpenGL3_Init()
+ * with the same GLSL version. Returns false when the GPU grid can't be
+ * used, in which case LoRISE() should be given no grid callback.
+ */
+bool InitGridRenderer(
+    const char* glsl_version)
+{
+    // Full-screen triangle needs gl_VertexID (GLSL 1.30 / ES 3.00)
+    if (glsl_version == NULL ||
+        strcmp(glsl_version, "#version 100") == 0 ||
+        strcmp(glsl_version, "#version 110") == 0 ||
+        strcmp(glsl_version, "#version 120") == 0)
+    {
+        return false;
+    }
+
+    if (LoadGLProcs() == false)
+    {
+        return false;
+    }
+
+    const char* vertex_source =
+        "void main()\n"
+        "{\n"
+        "    vec2 pos = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));\n"
+        "    gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);\n"
+        "}\n";
+
+    // Distance to the nearest line is measured in screen pixels so lines
+    // stay 1px wide at any zoom. Minor lines fade out before their spacing
+    // gets small enough to turn into noise, leaving only the major lines.
+    const char* fragment_source =
+        "#ifdef GL_ES\n"
+        "precision highp float;\n"
+        "#endif\n"
+        "uniform vec2 DisplayPos;\n"
+        "uniform vec2 FramebufferScale;\n"
+        "uniform float FramebufferHeight;\n"
+        "uniform vec2 Origin;\n"
+        "uniform vec2 Center;\n"
+        "uniform vec2 CameraPan;\n"
+        "uniform float CameraZoom;\n"
+        "uniform float CellSize;\n"
+        "uniform float MajorEvery;\n"
+        "uniform vec4 MinorColor;\n"
+        "uniform vec4 MajorColor;\n"
+        "out vec4 Out_Color;\n"
+        "float LineCoverage(vec2 world, float spacing)\n"
+        "{\n"
+        "    vec2 d = abs(mod(world + spacing * 0.5, spacing) - spacing * 0.5) * CameraZoom;\n"
+        "    return clamp(1.0 - min(d.x, d.y), 0.0, 1.0);\n"
+        "}\n"
+        "void main()\n"
+        "{\n"
+        "    vec2 screen = vec2(gl_FragCoord.x, FramebufferHeight - gl_FragCoord.y) / FramebufferScale + DisplayPos;\n"
+        "    vec2 world = (screen - Origin - Center) / CameraZoom + Center + CameraPan;\n"
+        "    float minor_fade = clamp((CellSize * CameraZoom - 4.0) / 8.0, 0.0, 1.0);\n"
+        "    float minor = LineCoverage(world, CellSize) * minor_fade;\n"
+        "    float major = LineCoverage(world, CellSize * MajorEvery);\n"
+        "    vec4 color = major > 0.0 ? MajorColor : MinorColor;\n"
+        "    Out_Color = vec4(color.rgb, color.a * max(minor, major));\n"
+        "}\n";
+
+    GLuint vertex_shader = CompileGridShader(
+        GL_VERTEX_SHADER,
+        glsl_version,
+        vertex_source);
+
+    GLuint fragment_shader = CompileGridShader(
+        GL_FRAGMENT_SHADER,
+        glsl_version,
+        fragment_source);
+
+    if (vertex_shader == 0 ||
+        fragment_shader == 0)
+    {
+        return false;
+    }
+
+    GLProcs& gl = GetGLProcs();
+    GLuint program = gl.CreateProgram();
+    gl.AttachShader(program, vertex_shader);
+    gl.AttachShader(program, fragment_shader);
+    gl.LinkProgram(program);
+    gl.DetachShader(program, vertex_shader);
+    gl.DetachShader(program, fragment_shader);
+    gl.DeleteShader(vertex_shader);
+    gl.DeleteShader(fragment_shader);
+
+    GLint status = 0;
+    gl.GetProgramiv(
+        program,
+        GL_LINK_STATUS,
+        &status);
+
+    if (status == GL_FALSE)
+    {
+        char log[1024];
+        gl.GetProgramInfoLog(
+            program,
+            sizeof(log),
+            NULL,
+            log);
+
+        fprintf(stderr, "Lo-RISE: grid shader failed to link:\n%s\n", log);
+        gl.DeleteProgram(program);
+        return false;
+    }
+
+    GridRendererData& data = GetGridRendererData();
+    data.program = program;
+    data.loc_display_pos = gl.GetUniformLocation(program, "DisplayPos");
+    data.loc_framebuffer_scale = gl.GetUniformLocation(program, "FramebufferScale");
+    data.loc_framebuffer_height = gl.GetUniformLocation(program, "FramebufferHeight");
+    data.loc_origin = gl.GetUniformLocation(program, "Origin");
+    data.loc_center = gl.GetUniformLocation(program, "Center");
+    data.loc_camera_pan = gl.GetUniformLocation(program, "CameraPan");
+    data.loc_camera_zoom = gl.GetUniformLocation(program, "CameraZoom");
+    data.loc_cell_size = gl.GetUniformLocation(program, "CellSize");
+    data.loc_major_every = gl.GetUniformLocation(program, "MajorEvery");
+    data.loc_minor_color = gl.GetUniformLocation(program, "MinorColor");
+    data.loc_major_color = gl.GetUniformLocation(program, "MajorColor");
+
+    return true;
+}
+
+/**
+ * @brief Release the grid shader.
+ */
+void ShutdownGridRenderer()
+{
+    GridRendererData& data = GetGridRendererData();
+    if (data.program != 0)
+    {
+        GetGLProcs().DeleteProgram(data.program);
+        data.program = 0;
+    }
+}
+
+/**
+ * @brief ImDrawCallback that draws the grid as a single full-screen triangle,
+ * clipped to the window. Runs inside ImGui_ImplOpenGL3_RenderDrawData().
+ */
+void DrawGridCallback(
+    const ImDrawList*,
+    const ImDrawCmd* cmd)
+{
+    GridRendererData& data = GetGridRendererData();
+    const GridParams* params = (const GridParams*)cmd->UserCallbackData;
+    ImDrawData* draw_data = ImGui::GetDrawData();
+
+    if (data.program == 0 ||
+        draw_data == NULL)
+    {
+        return;
+    }
+
+    ImVec2 clip_off = draw_data->DisplayPos;
+    ImVec2 clip_scale = draw_data->FramebufferScale;
+    float fb_height = draw_data->DisplaySize.y * clip_scale.y;
+
+    // Project the window clip rect into framebuffer space (Y is inverted in OpenGL)
+    ImVec2 clip_min = ImVec2(
+        (cmd->ClipRect.x - clip_off.x) * clip_scale.x,
+        (cmd->ClipRect.y - clip_off.y) * clip_scale.y);
+
+    ImVec2 clip_max = ImVec2(
+        (cmd->ClipRect.z - clip_off.x) * clip_scale.x,
+        (cmd->ClipRect.w - clip_off.y) * clip_scale.y);
+
+    if (clip_max.x <= clip_min.x ||
+        clip_max.y <= clip_min.y)
+    {
+        return;
+    }
+
+    glScissor(
+        (int)clip_min.x,
+        (int)(fb_height - clip_max.y),
+        (int)(clip_max.x - clip_min.x),
+        (int)(clip_max.y - clip_min.y));
+
+    ImVec4 minor_color = ImGui::ColorConvertU32ToFloat4(GridParams::MINOR_COLOR);
+    ImVec4 major_color = ImGui::ColorConvertU32ToFloat4(GridParams::MAJOR_COLOR);
+
+    GLProcs& gl = GetGLProcs();
+    gl.UseProgram(data.program);
+    gl.Uniform2f(data.loc_display_pos, clip_off.x, clip_off.y);
+    gl.Uniform2f(data.loc_framebuffer_scale, clip_scale.x, clip_scale.y);
+    gl.Uniform1f(data.loc_framebuffer_height, fb_height);
+    gl.Uniform2f(data.loc_origin, params->origin.x, params->origin.y);
+    gl.Uniform2f(data.loc_center, params->center.x, params->center.y);
+    gl.Uniform2f(data.loc_camera_pan, params->camera_pan.x, params->camera_pan.y);
+    gl.Uniform1f(data.loc_camera_zoom, params->camera_zoom);
+    gl.Uniform1f(data.loc_cell_size, GridParams::CELL_SIZE);
+    gl.Uniform1f(data.loc_major_every, (float)GridParams::MAJOR_EVERY);
+    gl.Uniform4f(data.loc_minor_color, minor_color.x, minor_color.y, minor_color.z, minor_color.w);
+    gl.Uniform4f(data.loc_major_color, major_color.x, major_color.y, major_color.z, major_color.w);
+
+    glDrawArrays(
+        GL_TRIANGLES,
+        0,
+        3);
+}
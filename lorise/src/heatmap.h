@@ -0,0 +1,173 @@
+#pragma once
+
+// Standard library includes
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// ImGui includes
+#include "imgui.h"
+#include "imgui_internal.h"
+
+// Lo-RISE includes
+#include "camera.h"
+#include "spatial_index.h"
+
+/**
+ * @brief Agent density drawn as one filled quad per occupied grid cell,
+ * replacing per-agent drawing when zoomed far out.
+ *
+ * Counts come straight from the agents' SpatialIndex, whose cells match
+ * the background grid (both 100 world units). The index is already kept
+ * up to date incrementally, touched only when an agent crosses into
+ * another cell, so the heatmap has no bins of its own to rebuild.
+ */
+class HeatmapLayer
+{
+public:
+    static constexpr float MAX_ZOOM = 0.2f;         // Zooms below this draw the heatmap instead of agents
+    static const int ALPHA = 160;
+
+    /**
+     * @brief Whether agents should be drawn as a heatmap at this zoom.
+     */
+    static bool ShouldDraw(
+        const float camera_zoom)
+    {
+        return camera_zoom < MAX_ZOOM;
+    }
+
+    /**
+     * @brief Draw the density of the cells overlapping the world-space view
+     * rect. Colors are scaled to the densest cell in view, on a log scale
+     * so sparse cells stay visible next to crowded ones.
+     */
+    void Draw(
+        ImDrawList* draw_list,
+        const CameraTransform& camera,
+        const ImVec2 world_min,
+        const ImVec2 world_max,
+        const SpatialIndex& index)
+    {
+        if (ramp[0] == 0)
+        {
+            BuildRamp();
+        }
+
+        cells.clear();
+        int max_count = 0;
+        index.QueryCells(
+            world_min,
+            world_max,
+            [&](int cx, int cy, const std::vector<int>& bucket)
+            {
+                if (bucket.empty() == true)
+                {
+                    return;
+                }
+
+                Cell cell;
+                cell.cx = cx;
+                cell.cy = cy;
+                cell.count = (int)bucket.size();
+                cells.push_back(cell);
+                max_count = std::max(
+                    max_count,
+                    cell.count);
+            });
+
+        if (cells.empty() == true)
+        {
+            return;
+        }
+
+        const float cell_size = index.cell_size;
+        const float inv_log_max = 1.0f / std::log(1.0f + (float)max_count);
+        const ImVec2 uv = draw_list->_Data->TexUvWhitePixel;
+        const int count = (int)cells.size();
+
+        // With 16-bit indices a reservation must fit a single index range
+        const int chunk_size = sizeof(ImDrawIdx) == 2 ?
+            ((1 << 16) - 1) / 4 :
+            count;
+
+        for (int start = 0;
+            start < count;
+            start += chunk_size)
+        {
+            int end = std::min(start + chunk_size, count);
+            draw_list->PrimReserve(
+                (end - start) * 6,
+                (end - start) * 4);
+
+            for (int ii = start;
+                ii < end;
+                ii++)
+            {
+                const Cell& cell = cells[ii];
+                float t = std::log(1.0f + (float)cell.count) * inv_log_max;
+                int shade = std::min((int)(t * (RAMP_SIZE - 1)), RAMP_SIZE - 1);
+
+                ImVec2 p_min = camera.WorldToScreen(ImVec2(
+                    cell.cx * cell_size,
+                    cell.cy * cell_size));
+
+                ImVec2 p_max = camera.WorldToScreen(ImVec2(
+                    (cell.cx + 1) * cell_size,
+                    (cell.cy + 1) * cell_size));
+
+                draw_list->PrimRectUV(
+                    p_min,
+                    p_max,
+                    uv,
+                    uv,
+                    ramp[shade]);
+            }
+        }
+    }
+
+private:
+    static const int RAMP_SIZE = 64;
+
+    /**
+     * @brief An occupied cell in view.
+     */
+    struct Cell
+    {
+        int cx;
+        int cy;
+        int count;
+    };
+
+    std::vector<Cell> cells;        // Kept between frames so drawing doesn't allocate
+    ImU32 ramp[RAMP_SIZE] = {};     // Sparse to dense colors
+
+    /**
+     * @brief Blue through yellow to red.
+     */
+    void BuildRamp()
+    {
+        const ImVec4 stops[] = {
+            ImVec4(0.1f, 0.3f, 1.0f, 1.0f),
+            ImVec4(1.0f, 1.0f, 0.2f, 1.0f),
+            ImVec4(1.0f, 0.1f, 0.1f, 1.0f) };
+
+        for (int ii = 0;
+            ii < RAMP_SIZE;
+            ii++)
+        {
+            float t = (float)ii / (RAMP_SIZE - 1) * 2.0f;
+            int stop = std::min((int)t, 1);
+            ImVec4 color = ImLerp(
+                stops[stop],
+                stops[stop + 1],
+                t - (float)stop);
+
+            ramp[ii] = IM_COL32(
+                (int)(color.x * 255),
+                (int)(color.y * 255),
+                (int)(color.z * 255),
+                ALPHA);
+        }
+    }
+};
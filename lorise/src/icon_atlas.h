@@ -0,0 +1,212 @@
+#pragma once
+
+// Standard library includes
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <stdio.h>
+#include <vector>
+
+// ImGui includes
+#include "imgui.h"
+#include "imgui_internal.h"
+
+// Lo-RISE includes
+#include "interactables.h"
+
+/**
+ * @brief Icons baked into the font atlas.
+ */
+enum IconId
+{
+    IconAirAgent,       // Triangle
+    IconGroundAgent,    // Square
+    IconSelection,      // Ring around selected agents
+    IconCount
+};
+
+/**
+ * @brief Where an icon sits in the font atlas. The icon is centered in
+ * a size x size rect with a transparent border.
+ */
+struct IconRect
+{
+    int rect_id = -1;
+    int size = 0;
+    ImVec2 uv_min = ImVec2(0, 0);
+    ImVec2 uv_max = ImVec2(0, 0);
+};
+
+/**
+ * @brief Icons rasterized into custom rects of the font atlas, so each
+ * one draws as a single textured quad sharing the font texture.
+ */
+struct IconAtlasData
+{
+    const ImFontAtlas* atlas = NULL;
+    IconRect icons[IconCount];
+    bool ready = false;
+};
+
+IconAtlasData& GetIconAtlas()
+{
+    static IconAtlasData data;
+    return data;
+}
+
+/**
+ * @brief Distance from p to the closed outline of a regular polygon,
+ * built the same way as BuildOutlineShape() builds it.
+ */
+float DistanceToOutline(
+    const ImVec2 p,
+    const float radius,
+    const int num_segments)
+{
+    float best_2 = FLT_MAX;
+    for (int ii = 0;
+        ii < num_segments;
+        ii++)
+    {
+        float a0 = (IM_PI * 2.0f) * (float)ii / (float)num_segments;
+        float a1 = (IM_PI * 2.0f) * (float)(ii + 1) / (float)num_segments;
+        ImVec2 p0 = ImVec2(
+            std::cos(a0) * (radius - 0.5f),
+            std::sin(a0) * (radius - 0.5f));
+
+        ImVec2 p1 = ImVec2(
+            std::cos(a1) * (radius - 0.5f),
+            std::sin(a1) * (radius - 0.5f));
+
+        ImVec2 edge = ImVec2(
+            p1.x - p0.x,
+            p1.y - p0.y);
+
+        float t = ((p.x - p0.x) * edge.x + (p.y - p0.y) * edge.y) /
+            (edge.x * edge.x + edge.y * edge.y);
+        t = std::max(std::min(t, 1.0f), 0.0f);
+
+        float dx = p.x - (p0.x + edge.x * t);
+        float dy = p.y - (p0.y + edge.y * t);
+        best_2 = std::min(best_2, dx * dx + dy * dy);
+    }
+
+    return std::sqrt(best_2);
+}
+
+/**
+ * @brief Write a 1px anti-aliased outline into an RGBA32 atlas rect, white
+ * so vertex colors tint it. Coverage fades over one pixel either side of
+ * the outline, like the fringe of ImDrawList's anti-aliased lines.
+ */
+void RasterizeOutlineIcon(
+    unsigned char* pixels,
+    const int tex_width,
+    const ImFontAtlasCustomRect& rect,
+    const float radius,
+    const int num_segments)
+{
+    const float half = rect.Width * 0.5f;
+    for (int yy = 0;
+        yy < rect.Height;
+        yy++)
+    {
+        unsigned char* row = pixels + ((size_t)(rect.Y + yy) * tex_width + rect.X) * 4;
+        for (int xx = 0;
+            xx < rect.Width;
+            xx++)
+        {
+            float distance = DistanceToOutline(
+                ImVec2(
+                    xx + 0.5f - half,
+                    yy + 0.5f - half),
+                radius,
+                num_segments);
+
+            float coverage = std::max(1.0f - distance, 0.0f);
+            row[xx * 4 + 0] = 255;
+            row[xx * 4 + 1] = 255;
+            row[xx * 4 + 2] = 255;
+            row[xx * 4 + 3] = (unsigned char)(coverage * 255.0f + 0.5f);
+        }
+    }
+}
+
+/**
+ * @brief Add the icons to the font atlas, build it and rasterize them.
+ * Must run before the renderer backend uploads the font texture.
+ * Returns false, leaving icons to be tessellated, if they didn't fit.
+ */
+bool InitIconAtlas(
+    ImFontAtlas* atlas)
+{
+    IconAtlasData& data = GetIconAtlas();
+    data = IconAtlasData();
+
+    struct IconShape
+    {
+        float radius;
+        int num_segments;
+    };
+
+    const IconShape shapes[IconCount] = {
+        { Agent::ICON_SIZE, 3 },
+        { Agent::ICON_SIZE, 4 },
+        { Agent::ICON_SIZE + 4, 12 } };
+
+    // Outline plus its fringe, and a transparent pixel all around so
+    // filtering at the quad's edge never reads a neighbouring rect
+    for (int ii = 0;
+        ii < IconCount;
+        ii++)
+    {
+        int size = 2 * ((int)std::ceil(shapes[ii].radius + 0.5f) + 1);
+        data.icons[ii].size = size;
+        data.icons[ii].rect_id = atlas->AddCustomRectRegular(
+            size,
+            size);
+    }
+
+    unsigned char* pixels = NULL;
+    int tex_width = 0;
+    int tex_height = 0;
+    atlas->GetTexDataAsRGBA32(
+        &pixels,
+        &tex_width,
+        &tex_height);
+
+    if (pixels == NULL)
+    {
+        fprintf(stderr, "Lo-RISE: font atlas failed to build, icons will be tessellated\n");
+        return false;
+    }
+
+    for (int ii = 0;
+        ii < IconCount;
+        ii++)
+    {
+        IconRect& icon = data.icons[ii];
+        const ImFontAtlasCustomRect* rect = atlas->GetCustomRectByIndex(icon.rect_id);
+        if (rect->IsPacked() == false)
+        {
+            fprintf(stderr, "Lo-RISE: icon %d didn't fit the font atlas, icons will be tessellated\n", ii);
+            return false;
+        }
+
+        RasterizeOutlineIcon(
+            pixels,
+            tex_width,
+            *rect,
+            shapes[ii].radius,
+            shapes[ii].num_segments);
+
+        atlas->CalcCustomRectUV(
+            rect,
+            &icon.uv_min,
+            &icon.uv_max);
+    }
+
+    data.atlas = atlas;
+    data.ready = true;
+    return true;
+}
@@ -0,0 +1,441 @@
+#pragma once
+
+// Standard library includes
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+// Lo-RISE includes
+#include "lorise.h"
+#include "utils/spsc_ring.h"
+
+/**
+ * @brief Agent status reported by the simulation.
+ */
+enum AgentStatus : uint8_t
+{
+    StatusAlive,
+    StatusTasked,
+    StatusDead
+};
+
+/**
+ * @brief One agent state sample. Also the wire format of the socket
+ * source: each datagram holds one or more packed 16-byte records in
+ * host byte order.
+ */
+struct AgentUpdate
+{
+    uint32_t agent;     // Index (slot) of the agent in the store
+    float x;            // World x-position
+    float y;            // World y-position
+    uint8_t status;     // AgentStatus
+    uint8_t air;        // Non-zero for air agents
+    uint8_t pad[2];
+
+    static constexpr float MAX_COORD = 1.0e7f;  // Positions further out are rejected as corrupt
+};
+
+static_assert(sizeof(AgentUpdate) == 16, "AgentUpdate is a wire format");
+
+/**
+ * @brief Receives agent updates on a background thread and hands them
+ * to the UI thread through a lock-free ring, so the UI never waits on I/O.
+ *
+ * Sources:
+ * - File replay: text lines of "<seconds> <agent> <x> <y> <alive|tasked|dead> [air]",
+ *   played back at their timestamps. Lines starting with '#' are ignored.
+ * - Local socket: UDP datagrams of AgentUpdate records sent to 127.0.0.1:<port>.
+ */
+class TelemetryIngest
+{
+public:
+    static const size_t DEFAULT_CAPACITY = 1 << 16;
+
+    explicit TelemetryIngest(
+        size_t capacity = DEFAULT_CAPACITY) :
+        ring(capacity)
+    {
+        batch.resize(ring.Capacity());
+    }
+
+    ~TelemetryIngest()
+    {
+        Stop();
+    }
+
+    /**
+     * @brief Start replaying a recorded text file. Speed scales the timestamps.
+     */
+    bool StartReplay(
+        const std::string& path,
+        const float speed = 1.0f)
+    {
+        Stop();
+
+        FILE* f = fopen(path.c_str(), "r");
+        if (f == NULL)
+        {
+            fprintf(stderr, "Lo-RISE: can't open telemetry replay %s\n", path.c_str());
+            return false;
+        }
+
+        running = true;
+        worker = std::thread(
+            &TelemetryIngest::ReplayLoop,
+            this,
+            f,
+            speed);
+
+        return true;
+    }
+
+    /**
+     * @brief Start listening for UDP datagrams on the loopback interface.
+     */
+    bool StartListen(
+        const uint16_t port)
+    {
+        Stop();
+
+#if defined(_WIN32)
+        WSADATA wsa_data;
+        if (WSAStartup(MAKEWORD(2, 2), &wsa_data) != 0)
+        {
+            return false;
+        }
+#endif
+
+        SocketHandle sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (sock == INVALID_SOCKET_HANDLE)
+        {
+            fprintf(stderr, "Lo-RISE: can't create telemetry socket\n");
+            return false;
+        }
+
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if (bind(sock, (const sockaddr*)&addr, sizeof(addr)) != 0)
+        {
+            fprintf(stderr, "Lo-RISE: can't bind telemetry socket to port %u\n", (unsigned int)port);
+            CloseSocket(sock);
+            return false;
+        }
+
+        // Wake up regularly so Stop() doesn't wait on a silent sender
+#if defined(_WIN32)
+        DWORD timeout_ms = 100;
+        setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout_ms, sizeof(timeout_ms));
+#else
+        timeval timeout;
+        timeout.tv_sec = 0;
+        timeout.tv_usec = 100 * 1000;
+        setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+#endif
+
+        running = true;
+        worker = std::thread(
+            &TelemetryIngest::ListenLoop,
+            this,
+            sock);
+
+        return true;
+    }
+
+    /**
+     * @brief Called from the background thread when updates are queued
+     * and the UI thread hasn't drained the previous ones yet. Lets an
+     * idle main loop wake up. Set before starting a source.
+     */
+    void SetWakeCallback(
+        void (*callback)())
+    {
+        wake_callback = callback;
+    }
+
+    /**
+     * @brief Stop the background thread. Pending updates stay queued.
+     */
+    void Stop()
+    {
+        running = false;
+        if (worker.joinable() == true)
+        {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief UI thread side. Move every queued update into the batch
+     * buffer and return how many there were.
+     */
+    size_t Drain()
+    {
+        wake_pending.store(false, std::memory_order_relaxed);
+        return ring.PopBatch(
+            batch.data(),
+            batch.size());
+    }
+
+    const AgentUpdate* Batch() const
+    {
+        return batch.data();
+    }
+
+    /**
+     * @brief Updates lost because the ring was full,
+     * or discarded by the UI thread as unusable.
+     */
+    uint64_t Dropped() const
+    {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Count updates the UI thread discarded as dropped.
+     */
+    void Discard(
+        const uint64_t count)
+    {
+        dropped.fetch_add(count, std::memory_order_relaxed);
+    }
+
+private:
+#if defined(_WIN32)
+    typedef SOCKET SocketHandle;
+    static constexpr SocketHandle INVALID_SOCKET_HANDLE = INVALID_SOCKET;
+    static void CloseSocket(SocketHandle sock) { closesocket(sock); WSACleanup(); }
+#else
+    typedef int SocketHandle;
+    static constexpr SocketHandle INVALID_SOCKET_HANDLE = -1;
+    static void CloseSocket(SocketHandle sock) { close(sock); }
+#endif
+
+    SpscRing<AgentUpdate> ring;
+    std::vector<AgentUpdate> batch;         // Consumer side scratch, filled by Drain()
+    std::thread worker;
+    std::atomic<bool> running{false};
+    std::atomic<uint64_t> dropped{0};
+    void (*wake_callback)() = NULL;
+    std::atomic<bool> wake_pending{false};     // Woken since the last Drain()
+
+    /**
+     * @brief Wake the UI thread once per batch of updates.
+     */
+    void NotifyQueued()
+    {
+        if (wake_callback != NULL &&
+            wake_pending.exchange(true, std::memory_order_relaxed) == false)
+        {
+            wake_callback();
+        }
+    }
+
+    /**
+     * @brief Push, waiting for room while running. Used by sources
+     * that can afford to slow down, like file replay.
+     */
+    void PushWaiting(
+        const AgentUpdate& update)
+    {
+        while (ring.Push(update) == false)
+        {
+            if (running == false)
+            {
+                return;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    /**
+     * @brief Push, dropping the update if the UI thread is behind.
+     * Used by live sources, where stale samples are worthless anyway.
+     */
+    void PushOrDrop(
+        const AgentUpdate& update)
+    {
+        if (ring.Push(update) == false)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void ReplayLoop(
+        FILE* f,
+        const float speed)
+    {
+        auto start = std::chrono::steady_clock::now();
+        char line[256];
+
+        while (running == true &&
+            fgets(line, sizeof(line), f) != NULL)
+        {
+            if (line[0] == '#' ||
+                line[0] == '\n')
+            {
+                continue;
+            }
+
+            double seconds = 0;
+            unsigned int agent = 0;
+            float x = 0;
+            float y = 0;
+            char status[16] = "";
+            char air[16] = "";
+            int fields = sscanf(line, "%lf %u %f %f %15s %15s", &seconds, &agent, &x, &y, status, air);
+            if (fields < 5)
+            {
+                continue;
+            }
+
+            AgentUpdate update;
+            memset(&update, 0, sizeof(update));
+            update.agent = agent;
+            update.x = x;
+            update.y = y;
+            update.status = strcmp(status, "dead") == 0 ?
+                StatusDead :
+                strcmp(status, "tasked") == 0 ?
+                    StatusTasked :
+                    StatusAlive;
+            update.air = fields == 6 && strcmp(air, "air") == 0;
+
+            // Sleep in short slices until the sample is due so Stop() stays responsive
+            auto due = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(seconds / speed));
+
+            while (running == true &&
+                std::chrono::steady_clock::now() < due)
+            {
+                auto remaining = due - std::chrono::steady_clock::now();
+                std::this_thread::sleep_for(std::min(
+                    remaining,
+                    std::chrono::steady_clock::duration(std::chrono::milliseconds(50))));
+            }
+
+            PushWaiting(update);
+            NotifyQueued();
+        }
+
+        fclose(f);
+    }
+
+    void ListenLoop(
+        SocketHandle sock)
+    {
+        AgentUpdate packet[64];
+
+        while (running == true)
+        {
+            int received = (int)recv(
+                sock,
+                (char*)packet,
+                sizeof(packet),
+                0);
+
+            if (received <= 0)
+            {
+                continue;
+            }
+
+            int count = received / (int)sizeof(AgentUpdate);
+            for (int ii = 0;
+                ii < count;
+                ii++)
+            {
+                PushOrDrop(packet[ii]);
+            }
+            NotifyQueued();
+        }
+
+        CloseSocket(sock);
+    }
+};
+
+/**
+ * @brief Apply every queued telemetry update to the agents. Call once
+ * per frame on the UI thread, before LoRISEFrame(). Updates for agents
+ * that don't exist or were removed are ignored, and updates with a NaN,
+ * infinite or beyond AgentUpdate::MAX_COORD position are counted as dropped. Returns the number of updates applied.
+ */
+int ApplyTelemetry(
+    TelemetryIngest& ingest,
+    LoRISEState& state)
+{
+    const ImU32 status_colors[] = {
+        Agent::ALIVE_COLOR,
+        Agent::TASKED_COLOR,
+        Agent::DEAD_COLOR };
+
+    size_t count = ingest.Drain();
+    const AgentUpdate* updates = ingest.Batch();
+    EntityStore& agents = state.agents;
+    int applied = 0;
+    int invalid = 0;
+
+    for (size_t ii = 0;
+        ii < count;
+        ii++)
+    {
+        const AgentUpdate& update = updates[ii];
+        int index = (int)update.agent;
+        if (agents.IsLive(index) == false ||
+            update.status > StatusDead)
+        {
+            continue;
+        }
+
+        // Datagrams are untrusted, and a NaN, infinite or far out position can't be indexed
+        if (std::isfinite(update.x) == false ||
+            std::isfinite(update.y) == false ||
+            std::fabs(update.x) > AgentUpdate::MAX_COORD ||
+            std::fabs(update.y) > AgentUpdate::MAX_COORD)
+        {
+            invalid++;
+            continue;
+        }
+
+        ImVec2 pos = ImVec2(
+            update.x,
+            update.y);
+
+        MoveAgent(
+            state,
+            index,
+            pos);
+
+        agents.color[index] = status_colors[update.status];
+        agents.SetFlag(index, EntityStore::Dead, update.status == StatusDead);
+        agents.SetFlag(index, EntityStore::Air, update.air != 0);
+        applied++;
+    }
+
+    if (invalid > 0)
+    {
+        ingest.Discard(invalid);
+    }
+
+    return applied;
+}
@@ -8,8 +8,12 @@
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
 
+// Lo-RISE includes
+#include "entity_store.h"
+
 /**
  * @brief Agent info. Would be replaced by the actual agent class.
+ * Only used to describe an agent when adding it to an EntityStore.
  */
 struct Agent
 {
@@ -27,6 +31,7 @@ struct Agent
 
 /**
  * @brief Tactic info. Would be replaced by the actual tactic class.
+ * Only used to describe a tactic when adding it to an EntityStore.
  */
 struct Tactic
 {
@@ -39,3 +44,41 @@ struct Tactic
     ImVec2 pos;
     ImU32 color;
 };
+
+/**
+ * @brief Add an agent to the entity store and return its index.
+ */
+int AddAgent(
+    EntityStore& agents,
+    const Agent& agent)
+{
+    int index = agents.Add(
+        agent.name,
+        agent.pos,
+        agent.color);
+
+    agents.SetFlag(
+        index,
+        EntityStore::Air,
+        agent.air);
+
+    agents.SetFlag(
+        index,
+        EntityStore::Dead,
+        agent.dead);
+
+    return index;
+}
+
+/**
+ * @brief Add a tactic to the entity store and return its index.
+ */
+int AddTactic(
+    EntityStore& tactics,
+    const Tactic& tactic)
+{
+    return tactics.Add(
+        tactic.name,
+        tactic.pos,
+        tactic.color);
+}
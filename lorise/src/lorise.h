@@ -5,100 +5,303 @@
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
 
+// Standard library includes
+#include <algorithm>
+#include <vector>
+
 // Lo-RISE includes
+#include "animation.h"
+#include "camera.h"
 #include "controls.h"
+#include "entity_renderer.h"
+#include "heatmap.h"
 #include "interactables.h"
+#include "spatial_index.h"
+#include "tile_layer.h"
+#include "trails.h"
 #include "utils/utils.h"
+#include "world_update.h"
 
 /**
- * @brief Draw an agent at the designated location.
+ * @brief Entities that survived culling this frame.
+ * Kept between frames so culling doesn't allocate.
  */
-void DrawAgent(
-    const ImVec2 camera_pan,
-    const float camera_zoom,
+struct VisibleSet
+{
+    std::vector<int> agents;
+    std::vector<int> tactics;
+};
+
+/**
+ * @brief Camera and interaction state a frame is drawn with,
+ * including any pan, zoom or drag gesture still in progress.
+ */
+struct LoRISEView
+{
+    ImVec2 camera_pan = ImVec2(0, 0);
+    float camera_zoom = 1;
+    Action current_action = Action::Idle;
+    int selected_tactic = -1;               // Index of the tactic interacted with this frame, -1 if none
+    ImVec2 tactic_drag = ImVec2(0, 0);      // Screen offset of the dragged tactic
+    ImVec2 selection_drag = ImVec2(0, 0);   // Screen offset of the dragged selection
+    ImVec2 select_box_start = ImVec2(0, 0); // Screen corners of the selection box being drawn
+    ImVec2 select_box_end = ImVec2(0, 0);
+};
+
+/**
+ * @brief Everything the Lo-RISE view keeps between frames.
+ */
+struct LoRISEState
+{
+    Action current_action = Action::Idle;   // Current action the user is performing
+    ImVec2 camera_pan = ImVec2(0, 0);       // Finalized camera pan offset
+    float camera_zoom = 1;                  // Finalized camera zoom factor
+    CameraAnimator camera_animator;         // Drawn camera, easing toward the input one
+    EntityHandle selected_tactic;           // Tactic currently being interacted with
+    Selection selected_agents;              // Agents picked with the selection box
+
+    EntityStore agents;                     // Agents to visualize
+    EntityStore tactics;                    // Tactics to visualize
+    SpatialIndex agent_index;               // World-space lookup of agents
+    SpatialIndex tactic_index;              // World-space lookup of tactics
+
+    VisibleSet visible;                     // Entities that survived culling
+    TileLayer imagery;                      // Map imagery under the grid, if a tile pack is open
+    TrailBuffer trails;                     // Recent path of every agent
+    MotionSmoother agent_motion;            // Drawn agent positions, eased between samples
+    HeatmapLayer heatmap;                   // Agent density, drawn instead of agents when zoomed far out
+    EntityRenderer renderer;                // Batched agent and tactic drawing
+    WorldUpdateStage world_update;          // Screen positions, transformed on worker threads
+};
+
+/**
+ * @brief Rebuild the spatial indices after entities were added in bulk.
+ */
+void IndexEntities(
+    LoRISEState& state)
+{
+    state.agent_index.Build(
+        state.agents.x.data(),
+        state.agents.y.data(),
+        state.agents.Size());
+
+    state.tactic_index.Build(
+        state.tactics.x.data(),
+        state.tactics.y.data(),
+        state.tactics.Size());
+
+    // Removed slots keep their last position, but must not be found
+    for (int ii = 0;
+        ii < state.agents.Size();
+        ii++)
+    {
+        if (state.agents.IsLive(ii) == false)
+        {
+            state.agent_index.Remove(ii);
+        }
+    }
+
+    for (int ii = 0;
+        ii < state.tactics.Size();
+        ii++)
+    {
+        if (state.tactics.IsLive(ii) == false)
+        {
+            state.tactic_index.Remove(ii);
+        }
+    }
+}
+
+/**
+ * @brief Add an agent while the view is running, e.g. from streaming
+ * updates. Returns a handle that stays valid until the agent is removed.
+ */
+EntityHandle InsertAgent(
+    LoRISEState& state,
     const Agent& agent)
 {
-    ImVec2 window_dims = ImGui::GetWindowSize();
-    ImVec2 center = ImVec2(
-        window_dims.x / 2,
-        window_dims.y / 2);
+    EntityHandle handle = state.agents.Insert(
+        agent.name,
+        agent.pos,
+        agent.color);
+
+    int index = (int)handle.index;
+    state.agents.SetFlag(index, EntityStore::Air, agent.air);
+    state.agents.SetFlag(index, EntityStore::Dead, agent.dead);
+    state.agent_index.Insert(index, agent.pos);
+    state.trails.Clear(index);
+    state.agent_motion.Snap(
+        index,
+        agent.pos.x,
+        agent.pos.y);
+    return handle;
+}
+
+/**
+ * @brief Remove an agent, freeing its slot for reuse. Indices of
+ * other agents don't change. Returns false if it was already removed.
+ */
+bool RemoveAgent(
+    LoRISEState& state,
+    const EntityHandle handle)
+{
+    int index = state.agents.Find(handle);
+    if (state.agents.Remove(handle) == false)
+    {
+        return false;
+    }
+
+    state.agent_index.Remove(index);
+    state.selected_agents.Remove(index);
+    return true;
+}
+
+/**
+ * @brief Add a tactic while the view is running.
+ */
+EntityHandle InsertTactic(
+    LoRISEState& state,
+    const Tactic& tactic)
+{
+    EntityHandle handle = state.tactics.Insert(
+        tactic.name,
+        tactic.pos,
+        tactic.color);
 
-    // Apply camera pan offset 
-    ImVec2 pos = ImVec2(
-        agent.pos.x - camera_pan.x,
-        agent.pos.y - camera_pan.y);
+    state.tactic_index.Insert((int)handle.index, tactic.pos);
+    return handle;
+}
 
-    // Apply zoom
-    pos.x = center.x + (pos.x - center.x) * camera_zoom;
-    pos.y = center.y + (pos.y - center.y) * camera_zoom;
+/**
+ * @brief Remove a tactic, freeing its slot for reuse.
+ */
+bool RemoveTactic(
+    LoRISEState& state,
+    const EntityHandle handle)
+{
+    int index = state.tactics.Find(handle);
+    if (state.tactics.Remove(handle) == false)
+    {
+        return false;
+    }
 
-    // Name needs to be centered below the given position
-    ImVec2 text_dims = ImGui::CalcTextSize(agent.name.c_str());
-    ImGui::SetCursorPosX(pos.x - (text_dims.x / 2));
-    ImGui::SetCursorPosY(pos.y - (text_dims.y / 2) + (Agent::ICON_SIZE * 2));
-    ImGui::TextColored(
-        (ImColor)agent.color,
-        agent.name.c_str());
+    state.tactic_index.Remove(index);
+    return true;
+}
 
-    ImDrawList* draw_list = ImGui::GetWindowDrawList();
-    draw_list->AddNgon(
-        pos,
-        Agent::ICON_SIZE,
-        agent.color,
-        agent.air ?
-            3 : 
-            4);
+/**
+ * @brief Move an agent, keeping everything derived from its position in sync.
+ */
+void MoveAgent(
+    LoRISEState& state,
+    const int index,
+    const ImVec2 pos)
+{
+    state.agents.SetPos(
+        index,
+        pos);
+
+    state.agent_index.Move(
+        index,
+        pos);
 }
 
 /**
- * @brief Draw a tactic icon at the designated location.
+ * @brief Move a tactic, keeping everything derived from its position in sync.
  */
-void DrawTacticIcon(
-    const ImVec2 camera_pan,
+void MoveTactic(
+    LoRISEState& state,
+    const int index,
+    const ImVec2 pos)
+{
+    state.tactics.SetPos(
+        index,
+        pos);
+
+    state.tactic_index.Move(
+        index,
+        pos);
+}
+
+/**
+ * @brief Pick how agents are drawn from the zoom and how many are on screen.
+ */
+DetailLevel GetAgentDetailLevel(
     const float camera_zoom,
-    const Tactic& tactic,
-    bool dragging = false)
+    const int visible_count)
 {
-    ImVec2 window_dims = ImGui::GetWindowSize();
-    ImVec2 center = ImVec2(
-        window_dims.x / 2,
-        window_dims.y / 2);
+    const float label_min_zoom = 0.75f;
+    const float icon_min_zoom = 0.3f;
+    const int label_budget = 1000;
+    const int icon_budget = 10000;
 
-    // Apply camera pan offset 
-    ImVec2 pos = ImVec2(
-        tactic.pos.x - camera_pan.x,
-        tactic.pos.y - camera_pan.y);
-    
-    // Apply camera zoom
-    pos.x = center.x + (pos.x - center.x) * camera_zoom;
-    pos.y = center.y + (pos.y - center.y) * camera_zoom;
-
-    // Account for user dragging a tactic
-    if (dragging == true)
+    if (camera_zoom < icon_min_zoom ||
+        visible_count > icon_budget)
     {
-        // TODO:
-        // Bindings for each action need to be accessible anywhere.
-        // Currently they are local vars in the respective action fnc.
-        ImVec2 drag = ImGui::GetMouseDragDelta(ImGuiMouseButton_Left);
-        pos.x += drag.x;
-        pos.y += drag.y;
+        return DetailLevel::Point;
     }
 
-    // Name needs to be centered on given position
-    ImVec2 text_dims = ImGui::CalcTextSize(tactic.name.c_str());
-    ImGui::SetCursorPosX(pos.x - (text_dims.x / 2));
-    ImGui::SetCursorPosY(pos.y - (text_dims.y / 2));
-    ImGui::TextColored(
-        (ImColor)tactic.color,
-        tactic.name.c_str());
+    if (camera_zoom < label_min_zoom ||
+        visible_count > label_budget)
+    {
+        return DetailLevel::IconOnly;
+    }
 
-    ImDrawList* draw_list = ImGui::GetWindowDrawList();
-    draw_list->AddCircle(
-        pos,
-        Tactic::ICON_SIZE * camera_zoom,
-        tactic.color);
+    return DetailLevel::Full;
 }
 
+/**
+ * @brief Collect, in index order, the entities whose position is inside
+ * the world-space rect. Positions may be up to reach away, along either
+ * axis, from where the spatial index has the entities.
+ */
+void CullEntities(
+    const WorldPositions& positions,
+    const SpatialIndex& index,
+    const ImVec2 world_min,
+    const ImVec2 world_max,
+    std::vector<int>& visible,
+    const float reach = 0)
+{
+    visible.clear();
+
+    index.QueryRect(
+        ImVec2(world_min.x - reach, world_min.y - reach),
+        ImVec2(world_max.x + reach, world_max.y + reach),
+        [&](int ii)
+        {
+            float x = positions.x[ii];
+            float y = positions.y[ii];
+            if (x >= world_min.x && x <= world_max.x &&
+                y >= world_min.y && y <= world_max.y)
+            {
+                visible.push_back(ii);
+            }
+        });
+
+    // Cells are visited in hash order, keep draw order stable
+    std::sort(
+        visible.begin(),
+        visible.end());
+}
+
+/**
+ * @brief Grid layout and the camera state needed to draw it.
+ * Also passed by value to the GPU grid through ImDrawList::AddCallback().
+ */
+struct GridParams
+{
+    static constexpr float CELL_SIZE = 100.0f;
+    static constexpr int MAJOR_EVERY = 10;
+    static const ImU32 MINOR_COLOR = IM_COL32(255, 255, 255, 20);
+    static const ImU32 MAJOR_COLOR = IM_COL32(255, 255, 255, 50);
+
+    ImVec2 camera_pan;
+    float camera_zoom;
+    ImVec2 origin;      // Window position in screen space
+    ImVec2 center;      // Zoom reference point, relative to origin
+};
+
 /**
  * @brief Draws the grid background.
  */
@@ -106,8 +309,9 @@ void DrawGrid(
     const ImVec2 camera_pan,
     const float camera_zoom)
 {
-    const float cell_size = 100.0f;
-    const ImU32 grid_color = IM_COL32(255, 255, 255, 20);
+    const float cell_size = GridParams::CELL_SIZE;
+    const ImU32 minor_color = GridParams::MINOR_COLOR;
+    const ImU32 major_color = GridParams::MAJOR_COLOR;
     ImVec2 window_dims = ImGui::GetWindowSize();
     ImDrawList* draw_list = ImGui::GetWindowDrawList();
 
@@ -135,14 +339,19 @@ void DrawGrid(
     int row_start = (camera_pan.y - zoom_offsets.y) / cell_size;
     int row_end = row_start + (window_dims.y / (cell_size * camera_zoom)) + 2;
 
+    CameraTransform camera = CameraTransform(
+        ImVec2(0, 0),
+        center,
+        camera_pan,
+        camera_zoom);
+
     // Vertical lines
     for (int ii = col_start;
         ii < col_end;
         ii++)
     {
         // X-position with pan and zoom factor
-        float x = (ii * cell_size) - camera_pan.x;
-        x = center.x + (x - center.x) * camera_zoom;
+        float x = camera.WorldToScreen(ImVec2(ii * cell_size, 0)).x;
 
         // Ignore columns that are out of view
         if (x < 0 ||
@@ -164,7 +373,9 @@ void DrawGrid(
         draw_list->AddLine(
             top,
             bottom,
-            grid_color);
+            ii % GridParams::MAJOR_EVERY == 0 ?
+                major_color :
+                minor_color);
     }
 
     // Horizontal lines
@@ -173,8 +384,7 @@ void DrawGrid(
         jj++)
     {
         // Y-position with pan and zoom factor
-        float y = (jj * cell_size) - camera_pan.y;
-        y = center.y + (y - center.y) * camera_zoom;
+        float y = camera.WorldToScreen(ImVec2(0, jj * cell_size)).y;
 
         // Ignore rows that are out of view
         if (y < 0 ||
@@ -196,31 +406,64 @@ void DrawGrid(
         draw_list->AddLine(
             left,
             right,
-            grid_color);
+            jj % GridParams::MAJOR_EVERY == 0 ?
+                major_color :
+                minor_color);
     }
 }
 
 /**
  * @brief Draws the top down environmental view.
+ * Map imagery, if any, goes under the grid. When a grid callback is
+ * given the grid is left to the renderer backend, otherwise it is
+ * built on the CPU with DrawGrid().
  */
 void LoRISE(
     bool& show_lorise,
     const ImGuiIO& io,
-    const ImVec2 camera_pan,
-    const float camera_zoom,
-    const Action current_action,
-    const Tactic* selected_tactic,
-    const std::vector<Agent>& agents,
-    const std::vector<Tactic>& tactics)
+    const LoRISEView& view,
+    LoRISEState& state,
+    ImDrawCallback grid_callback = NULL)
 {
     if (show_lorise == false)
     {
         return;
     }
 
+    const ImVec2 camera_pan = view.camera_pan;
+    const float camera_zoom = view.camera_zoom;
+    VisibleSet& visible = state.visible;
+
+    // Agents are drawn, trailed and culled where they are eased to, not at their targets
+    state.agent_motion.Update(
+        state.agents,
+        io.DeltaTime);
+
+    const WorldPositions agent_positions = WorldPositions(
+        state.agent_motion.X(),
+        state.agent_motion.Y(),
+        state.agent_motion.Size());
+
+    state.trails.Sample(
+        agent_positions,
+        ImGui::GetTime());
+
     ImGui::SetNextWindowSize(io.DisplaySize);
     ImGui::SetNextWindowPos(ImVec2(0, 0));
 
+    // The window always covers the display, so every entity's screen
+    // position is known up front. Workers transform them while the
+    // imagery, grid and culling are built below.
+    state.world_update.Begin(
+        agent_positions,
+        state.tactics,
+        ImVec2(0, 0),
+        ImVec2(
+            io.DisplaySize.x / 2,
+            io.DisplaySize.y / 2),
+        camera_pan,
+        camera_zoom);
+
     ImGui::Begin(
         "LO-RISE",
         &show_lorise,
@@ -229,32 +472,358 @@ void LoRISE(
             ImGuiWindowFlags_NoResize |
             ImGuiWindowFlags_NoMove);
 
-    DrawGrid(
+    state.imagery.Draw(
+        ImGui::GetWindowDrawList(),
+        ImGui::GetWindowPos(),
+        ImGui::GetWindowSize(),
         camera_pan,
         camera_zoom);
 
-    for (Agent agent : agents)
+    if (grid_callback != NULL)
+    {
+        ImVec2 window_dims = ImGui::GetWindowSize();
+        GridParams grid_params;
+        grid_params.camera_pan = camera_pan;
+        grid_params.camera_zoom = camera_zoom;
+        grid_params.origin = ImGui::GetWindowPos();
+        grid_params.center = ImVec2(
+            window_dims.x / 2,
+            window_dims.y / 2);
+
+        // Callback changes GL state, so have the backend restore it
+        ImDrawList* grid_draw_list = ImGui::GetWindowDrawList();
+        grid_draw_list->AddCallback(
+            grid_callback,
+            &grid_params,
+            sizeof(grid_params));
+
+        grid_draw_list->AddCallback(
+            ImDrawCallback_ResetRenderState,
+            NULL);
+    }
+    else
     {
-        DrawAgent(
+        DrawGrid(
             camera_pan,
-            camera_zoom,
-            agent);
+            camera_zoom);
+    }
+
+    // World-space view rect, padded so icons and
+    // labels straddling the window edge still draw
+    const float margin = 64.0f / camera_zoom;
+    ImVec2 window_dims = ImGui::GetWindowSize();
+    ImVec2 center = ImVec2(
+        window_dims.x / 2,
+        window_dims.y / 2);
+
+    CameraTransform camera = CameraTransform(
+        ImVec2(0, 0),
+        center,
+        camera_pan,
+        camera_zoom);
+
+    ImVec2 world_min = camera.ScreenToWorld(ImVec2(0, 0));
+    ImVec2 world_max = camera.ScreenToWorld(window_dims);
+
+    world_min = ImVec2(world_min.x - margin, world_min.y - margin);
+    world_max = ImVec2(world_max.x + margin, world_max.y + margin);
+
+    // Zoomed far out agents are only drawn as density,
+    // so there's no need to know which ones are in view
+    const bool agent_heatmap = HeatmapLayer::ShouldDraw(camera_zoom);
+    if (agent_heatmap == true)
+    {
+        visible.agents.clear();
+    }
+    else
+    {
+        CullEntities(
+            agent_positions,
+            state.agent_index,
+            world_min,
+            world_max,
+            visible.agents,
+            state.agent_motion.MaxOffset());
     }
 
-    for (Tactic tactic : tactics)
+    CullEntities(
+        WorldPositions(state.tactics),
+        state.tactic_index,
+        world_min,
+        world_max,
+        visible.tactics);
+
+    // A dragged tactic is drawn under the mouse, not at its world position
+    int dragged_tactic = view.current_action == Action::DragTactic ?
+        view.selected_tactic :
+        -1;
+
+    if (dragged_tactic != -1 &&
+        std::binary_search(
+            visible.tactics.begin(),
+            visible.tactics.end(),
+            dragged_tactic) == false)
     {
-        // TODO:
-        // Will need a proper operator== for tactics instead of name matching
-        bool dragging = 
-            current_action == Action::DragTactic &&
-            selected_tactic->name == tactic.name;
+        visible.tactics.push_back(dragged_tactic);
+    }
 
-        DrawTacticIcon(
-            camera_pan,
-            camera_zoom,
-            tactic,
-            dragging);
+    DetailLevel agent_detail = GetAgentDetailLevel(
+        camera_zoom,
+        (int)visible.agents.size());
+
+    // Tactic labels go with agent labels, but tactics
+    // are never reduced to points since they are few
+    DetailLevel tactic_detail = agent_detail == DetailLevel::Full ?
+        DetailLevel::Full :
+        DetailLevel::IconOnly;
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    const RenderSnapshot& snapshot = state.world_update.End();
+
+    if (agent_heatmap == true)
+    {
+        state.heatmap.Draw(
+            draw_list,
+            camera,
+            world_min,
+            world_max,
+            state.agent_index);
+    }
+
+    // Trails go under the icons, and would only be noise at point detail
+    if (agent_detail != DetailLevel::Point)
+    {
+        state.trails.Draw(
+            draw_list,
+            camera,
+            snapshot.agents,
+            state.agents,
+            visible.agents);
+    }
+
+    state.renderer.BeginLabels(
+        ImGui::GetWindowPos(),
+        window_dims);
+
+    state.renderer.DrawAgents(
+        draw_list,
+        snapshot.agents,
+        state.agents,
+        visible.agents,
+        state.selected_agents,
+        view.current_action == Action::DragSelection ?
+            view.selection_drag :
+            ImVec2(0, 0),
+        agent_detail);
+
+    state.renderer.DrawTactics(
+        draw_list,
+        snapshot.tactics,
+        camera_zoom,
+        state.tactics,
+        visible.tactics,
+        dragged_tactic,
+        view.tactic_drag,
+        tactic_detail);
+
+    if (view.current_action == Action::BoxSelect)
+    {
+        ImVec2 box_min = ImVec2(
+            std::min(view.select_box_start.x, view.select_box_end.x),
+            std::min(view.select_box_start.y, view.select_box_end.y));
+
+        ImVec2 box_max = ImVec2(
+            std::max(view.select_box_start.x, view.select_box_end.x),
+            std::max(view.select_box_start.y, view.select_box_end.y));
+
+        draw_list->AddRectFilled(
+            box_min,
+            box_max,
+            EntityRenderer::SELECTION_FILL_COLOR);
+
+        draw_list->AddRect(
+            box_min,
+            box_max,
+            EntityRenderer::SELECTION_COLOR);
     }
 
     ImGui::End();
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Handle mouse interaction with the Lo-RISE view and
+ * return the view the frame should be drawn with.
+ */
+LoRISEView HandleLoRISEInput(
+    const ImGuiIO& io,
+    LoRISEState& state)
+{
+    ImVec2 pan_drag = ImVec2(0, 0);
+    float zoom_drag = 1;
+
+    // Entities are picked where they are on screen, and the drawn
+    // camera lags the input one while it eases after a pan or zoom
+    ImVec2 drawn_pan = state.camera_pan;
+    float drawn_zoom = state.camera_zoom;
+    state.camera_animator.Drawn(
+        drawn_pan,
+        drawn_zoom);
+
+    // Selection key bindings
+    if (state.selected_agents.Empty() == false)
+    {
+        if (ImGui::IsKeyPressed(ImGuiKey_Escape) == true)
+        {
+            state.selected_agents.Clear();
+        }
+        else if (ImGui::IsKeyPressed(ImGuiKey_T) == true)
+        {
+            RecolorSelected(
+                state.agents,
+                state.selected_agents,
+                Agent::TASKED_COLOR);
+        }
+    }
+
+    // Left mouse hold handling
+    if (ImGui::IsMouseDown(ImGuiMouseButton_Left) == true ||
+        ImGui::IsMouseReleased(ImGuiMouseButton_Left) == true)
+    {
+        BoxSelectAgents(
+            io,
+            drawn_pan,
+            drawn_zoom,
+            state.current_action,
+            state.agents,
+            state.agent_index,
+            state.selected_agents);
+
+        DragTacticIcon(
+            io,
+            drawn_pan,
+            drawn_zoom,
+            state.current_action,
+            state.tactics,
+            state.tactic_index,
+            state.selected_tactic);
+
+        DragSelectedAgents(
+            io,
+            drawn_pan,
+            drawn_zoom,
+            state.current_action,
+            state.agents,
+            state.agent_index,
+            state.selected_agents);
+
+        pan_drag = PanCamera(
+            state.camera_pan,
+            state.camera_zoom,
+            state.current_action);
+
+        // Common action cleanup on mouse release,
+        // also prevents actions from resetting to 
+        // idle and prematurely starting other actions.
+        if (ImGui::IsMouseReleased(ImGuiMouseButton_Left) == true)
+        {
+            state.selected_tactic = EntityHandle();
+            state.current_action = Action::Idle;
+        }
+    }
+
+    // Right mouse hold handling
+    else if (ImGui::IsMouseDown(ImGuiMouseButton_Right) == true ||
+        ImGui::IsMouseReleased(ImGuiMouseButton_Right) == true)
+    {
+        zoom_drag = ZoomCamera(
+            state.camera_zoom,
+            state.current_action);
+
+        // Common action cleanup on mouse release,
+        // also prevents actions from resetting to 
+        // idle and prematurely starting other actions.
+        if (ImGui::IsMouseReleased(ImGuiMouseButton_Right) == true)
+        {
+            state.selected_tactic = EntityHandle();
+            state.current_action = Action::Idle;
+        }
+    }
+
+    // Camera pan passed to visuals is sum of 
+    // finalized and in progress camera panning
+    ImVec2 full_camera_pan = ImVec2(
+        state.camera_pan.x - pan_drag.x,
+        state.camera_pan.y - pan_drag.y);
+
+    float full_camera_zoom = state.camera_zoom * zoom_drag;
+
+    LoRISEView view;
+    view.camera_pan = full_camera_pan;
+    view.camera_zoom = full_camera_zoom;
+    view.current_action = state.current_action;
+    view.selected_tactic = state.tactics.Find(state.selected_tactic);
+
+    // TODO:
+    // Bindings for each action need to be accessible anywhere.
+    // Currently they are local vars in the respective action fnc.
+    if (state.current_action == Action::DragTactic)
+    {
+        view.tactic_drag = ImGui::GetMouseDragDelta(ImGuiMouseButton_Left);
+    }
+    else if (state.current_action == Action::DragSelection)
+    {
+        view.selection_drag = ImGui::GetMouseDragDelta(ImGuiMouseButton_Left);
+    }
+    else if (state.current_action == Action::BoxSelect)
+    {
+        view.select_box_start = io.MouseClickedPos[ImGuiMouseButton_Left];
+        view.select_box_end = ImGui::GetMousePos();
+    }
+
+    return view;
+}
+
+/**
+ * @brief Handle mouse interaction with the Lo-RISE view, then draw it.
+ * Returns the view that was drawn.
+ */
+LoRISEView LoRISEFrame(
+    bool& show_lorise,
+    const ImGuiIO& io,
+    LoRISEState& state,
+    ImDrawCallback grid_callback = NULL)
+{
+    if (show_lorise == false)
+    {
+        return LoRISEView();
+    }
+
+    LoRISEView view = HandleLoRISEInput(
+        io,
+        state);
+
+    state.camera_animator.Update(
+        view.camera_pan,
+        view.camera_zoom,
+        io.DeltaTime);
+
+    LoRISE(
+        show_lorise,
+        io,
+        view,
+        state,
+        grid_callback);
+
+    return view;
+}
+
+/**
+ * @brief Whether the camera or any agent is still easing toward where
+ * it should be, so frames must keep coming even without input.
+ */
+bool LoRISEAnimating(
+    const LoRISEState& state)
+{
+    return state.camera_animator.Animating() == true ||
+        state.agent_motion.Animating() == true;
+}
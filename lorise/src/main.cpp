@@ -10,6 +10,8 @@
 // Standard library includes
 #include <iostream>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <vector>
 
 // ImGui includes
@@ -25,8 +27,12 @@
 #include <GLFW/glfw3.h> // Will drag system OpenGL headers
 
 // Lo-RISE includes
+#include "grid_renderer.h"
+#include "ingest.h"
 #include "main_menu.h"
 #include "lorise.h"
+#include "recorder.h"
+#include "utils/frame_pacer.h"
 
 // [Win32] Our example includes a copy of glfw3.lib pre-compiled with VS2010 to maximize ease of testing and compatibility with old VS compilers.
 // To link with VS2010-era libraries, VS2015+ requires linking with legacy_stdio_definitions.lib, which we do using this pragma.
@@ -45,9 +51,68 @@ static void glfw_error_callback(int error, const char* description)
     fprintf(stderr, "GLFW Error %d: %s\n", error, description);
 }
 
+// Map tiles are decoded and uploaded by the texture manager
+struct ManagedTileSource : public TileTextureSource
+{
+    TextureManager& textures;
+
+    explicit ManagedTileSource(
+        TextureManager& texture_manager) :
+        textures(texture_manager)
+    {
+    }
+
+    ImTextureID Acquire(
+        const std::string& key,
+        const unsigned char* data,
+        const size_t size) override
+    {
+        ManagedTexture texture = textures.GetMemory(
+            key,
+            data,
+            size);
+
+        return texture.ready == true ?
+            texture.TexID() :
+            0;
+    }
+
+    void Release(
+        const std::string& key) override
+    {
+        textures.Release(key);
+    }
+};
+
 // Main code
-int main(int, char**)
+// Usage: lorise.out [--replay <telemetry file> [--replay-speed <factor>]] [--listen <udp port>]
+//                   [--record <session log>] [--play <session log> [--play-speed <factor>]]
+//                   [--max-idle <seconds, 0 redraws continuously>] [--imagery <tile pack>]
+int main(int argc, char** argv)
 {
+    const char* replay_path = NULL;
+    float replay_speed = 1.0f;
+    int listen_port = 0;
+    const char* record_path = NULL;
+    const char* play_path = NULL;
+    float play_speed = 1.0f;
+    double max_idle = 0.5;
+    const char* imagery_path = NULL;
+
+    for (int ii = 1;
+        ii + 1 < argc;
+        ii += 2)
+    {
+        if (strcmp(argv[ii], "--replay") == 0)              replay_path = argv[ii + 1];
+        else if (strcmp(argv[ii], "--replay-speed") == 0)   replay_speed = (float)atof(argv[ii + 1]);
+        else if (strcmp(argv[ii], "--listen") == 0)         listen_port = atoi(argv[ii + 1]);
+        else if (strcmp(argv[ii], "--record") == 0)         record_path = argv[ii + 1];
+        else if (strcmp(argv[ii], "--play") == 0)           play_path = argv[ii + 1];
+        else if (strcmp(argv[ii], "--play-speed") == 0)     play_speed = (float)atof(argv[ii + 1]);
+        else if (strcmp(argv[ii], "--max-idle") == 0)       max_idle = atof(argv[ii + 1]);
+        else if (strcmp(argv[ii], "--imagery") == 0)        imagery_path = argv[ii + 1];
+    }
+
     glfwSetErrorCallback(glfw_error_callback);
     if (!glfwInit())
         return 1;
@@ -99,6 +164,13 @@ int main(int, char**)
     ImGui::StyleColorsDark();
     //ImGui::StyleColorsLight();
 
+    // Only draw when something changed, the backend chains our event callbacks
+#ifdef __EMSCRIPTEN__
+    max_idle = 0;
+#endif
+    FramePacer pacer(max_idle);
+    pacer.InstallCallbacks(window);
+
     // Setup Platform/Renderer backends
     ImGui_ImplGlfw_InitForOpenGL(window, true);
 #ifdef __EMSCRIPTEN__
@@ -106,6 +178,11 @@ int main(int, char**)
 #endif
     ImGui_ImplOpenGL3_Init(glsl_version);
 
+    // Draw the background grid in a shader when the GL version allows it
+    ImDrawCallback grid_callback = InitGridRenderer(glsl_version) ?
+        DrawGridCallback :
+        NULL;
+
     // Load Fonts
     // - If no fonts are loaded, dear imgui will use the default font. You can also load multiple fonts and use ImGui::PushFont()/PopFont() to select them.
     // - AddFontFromFileTTF() will return the ImFont* so you can store it if you need to select the font among multiple.
@@ -123,43 +200,97 @@ int main(int, char**)
     //ImFont* font = io.Fonts->AddFontFromFileTTF("c:\\Windows\\Fonts\\ArialUni.ttf", 18.0f, nullptr, io.Fonts->GetGlyphRangesJapanese());
     //IM_ASSERT(font != nullptr);
 
+    // Agent icons go into the font atlas, which this builds
+    InitIconAtlas(io.Fonts);
+
     ImVec4 clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
 
+    // Images decoded in the background, uploaded a little each frame
+    TextureManager textures;
+    textures.SetWakeCallback(FramePacer::Wake);
+    textures.Init();
+
     // Our state
     bool show_main_menu = true;             // Display main menu
     bool show_lorise = false;               // Display Lo-RISE window
-    Action current_action = Action::Idle;   // Current action the user is performing
-    ImVec2 camera_pan = ImVec2(0, 0);       // Finalized camera pan offset
-    float camera_zoom = 1;                  // Finalized camera zoom factor
-    Tactic* selected_tactic = NULL;         // Tactic currently being interacted with
+    LoRISEState lorise;                     // Camera, interaction and entities of the Lo-RISE view
 
-    std::vector<Agent> agents = {           // List of agents to visualize
+    AddAgent(
+        lorise.agents,
         {
             "ARNOLD",
             false,
             false,
             ImVec2(400, 500),
             Agent::ALIVE_COLOR
-        },
+        });
+
+    AddAgent(
+        lorise.agents,
         {
             "BOB",
             true,
             false,
             ImVec2(300, 300),
             Agent::TASKED_COLOR
-        }};
+        });
 
-    std::vector<Tactic> tactics = {         // List of tactics to visualize
+    AddTactic(
+        lorise.tactics,
         {
             "ISR",
             ImVec2(100, 100),
             Tactic::WIP_COLOR
-        },
+        });
+
+    AddTactic(
+        lorise.tactics,
         {
             "ATTACK",
             ImVec2(100, 400),
             Tactic::FAILED_COLOR
-        }};
+        });
+
+    IndexEntities(lorise);
+
+    ManagedTileSource tile_source(textures);
+    if (imagery_path != NULL)
+    {
+        lorise.imagery.Open(
+            imagery_path,
+            tile_source);
+    }
+
+    // Agent state updates arriving in the background
+    TelemetryIngest ingest;
+    ingest.SetWakeCallback(FramePacer::Wake);
+    if (replay_path != NULL)
+    {
+        ingest.StartReplay(
+            replay_path,
+            replay_speed);
+    }
+    else if (listen_port > 0)
+    {
+        ingest.StartListen((uint16_t)listen_port);
+    }
+
+    // Session logs, written as the view is drawn or played back instead of live input
+    SessionRecorder recorder;
+    SessionPlayer player;
+    bool play_paused = false;
+    if (play_path != NULL)
+    {
+        player.Open(play_path);
+    }
+    else if (record_path != NULL)
+    {
+        int window_w, window_h;
+        glfwGetWindowSize(window, &window_w, &window_h);
+        recorder.Open(
+            record_path,
+            ImVec2((float)window_w, (float)window_h));
+    }
 
     // Main loop
 #ifdef __EMSCRIPTEN__
@@ -176,7 +307,11 @@ int main(int, char**)
         // - When io.WantCaptureMouse is true, do not dispatch mouse input data to your main application, or clear/overwrite your copy of the mouse data.
         // - When io.WantCaptureKeyboard is true, do not dispatch keyboard input data to your main application, or clear/overwrite your copy of the keyboard data.
         // Generally you may always pass all inputs to dear imgui, and hide them from your application based on those two flags.
-        glfwPollEvents();
+        // Frames are only drawn on input, queued telemetry, animation or after max_idle.
+        if (pacer.WaitForFrame() == false)
+        {
+            continue;
+        }
         if (glfwGetWindowAttrib(window, GLFW_ICONIFIED) != 0)
         {
             ImGui_ImplGlfw_Sleep(10);
@@ -193,79 +328,65 @@ int main(int, char**)
             MainMenu(
                 show_main_menu,
                 show_lorise,
-                io);
+                io,
+                textures);
         }
 
-        if (show_lorise == true)
+        if (player.IsOpen() == true)
         {
-            ImVec2 pan_drag = ImVec2(0, 0);
-            float zoom_drag = 1;
-
-            // Left mouse hold handling
-            if (ImGui::IsMouseDown(ImGuiMouseButton_Left) == true ||
-                ImGui::IsMouseReleased(ImGuiMouseButton_Left) == true)
+            if (show_lorise == true)
             {
-                // TODO:
-                // can add if modifier_key is down, then draw
-
-                DragTacticIcon(
+                if (PlaybackControls(
+                    player,
+                    lorise,
                     io,
-                    camera_pan,
-                    camera_zoom,
-                    current_action,
-                    tactics,
-                    selected_tactic);
-
-                pan_drag = PanCamera(
-                    camera_pan,
-                    camera_zoom,
-                    current_action);
-
-                // Common action cleanup on mouse release,
-                // also prevents actions from resetting to 
-                // idle and prematurely starting other actions.
-                if (ImGui::IsMouseReleased(ImGuiMouseButton_Left) == true)
+                    play_speed,
+                    play_paused) == true)
                 {
-                    selected_tactic = NULL;
-                    current_action = Action::Idle;
+                    pacer.RequestFrame();
                 }
+
+                LoRISE(
+                    show_lorise,
+                    io,
+                    player.View(),
+                    lorise,
+                    grid_callback);
             }
+        }
+        else
+        {
+            ApplyTelemetry(
+                ingest,
+                lorise);
 
-            // Right mouse hold handling
-            else if (ImGui::IsMouseDown(ImGuiMouseButton_Right) == true ||
-                ImGui::IsMouseReleased(ImGuiMouseButton_Right) == true)
+            LoRISEView view = LoRISEFrame(
+                show_lorise,
+                io,
+                lorise,
+                grid_callback);
+
+            if (show_lorise == true)
             {
-                zoom_drag = ZoomCamera(
-                    camera_zoom,
-                    current_action);
-
-                // Common action cleanup on mouse release,
-                // also prevents actions from resetting to 
-                // idle and prematurely starting other actions.
-                if (ImGui::IsMouseReleased(ImGuiMouseButton_Right) == true)
-                {
-                    selected_tactic = NULL;
-                    current_action = Action::Idle;
-                }
+                recorder.RecordFrame(
+                    ImGui::GetTime(),
+                    view,
+                    lorise);
             }
+        }
 
-            // Camera pan passed to visuals is sum of 
-            // finalized and in progress camera panning
-            ImVec2 full_camera_pan = ImVec2(
-                camera_pan.x - pan_drag.x,
-                camera_pan.y - pan_drag.y);
-
-            float full_camera_zoom = camera_zoom * zoom_drag;
+        // Keep drawing until every requested texture is on screen
+        textures.Update();
+        if (textures.Uploading() == true)
+        {
+            pacer.RequestFrame();
+        }
 
-            LoRISE(
-                show_lorise,
-                io,
-                full_camera_pan,
-                full_camera_zoom,
-                current_action,
-                selected_tactic,
-                agents,
-                tactics);
+        // and until the camera and agents have eased into place
+        if (show_lorise == true &&
+            LoRISEAnimating(lorise) == true)
+        {
+            pacer.RequestFrame();
         }
 
         // Rendering
@@ -284,6 +405,11 @@ int main(int, char**)
 #endif
 
     // Cleanup
+    ingest.Stop();
+    recorder.Close();
+    ShutdownGridRenderer();
+    textures.Shutdown();        // Joins the decode workers before the tile pack they read is unmapped
+    lorise.imagery.Close();
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
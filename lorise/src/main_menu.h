@@ -5,6 +5,7 @@
 
 // ImGui includes
 #include "imgui.h"
+#include "imgui_internal.h"
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
 
@@ -16,31 +17,34 @@
 #include <GLFW/glfw3.h> // Will drag system OpenGL headers
 
 // Lo-RISE includes
+#include "utils/texture_manager.h"
 #include "utils/utils.h"
 
+/**
+ * @brief Geometry of the main menu's logo and title, kept across frames.
+ */
+ImGuiDrawCache& GetMainMenuCache()
+{
+    static ImGuiDrawCache cache;
+    return cache;
+}
+
 /**
  * @brief Draws the main menu window.
  */
 void MainMenu(
     bool& show_main_menu,
     bool& show_lorise,
-    const ImGuiIO& io)
+    const ImGuiIO& io,
+    TextureManager& textures)
 {
     if (show_main_menu == false)
     {
         return;
     }
 
-    // // This should go outside of the main loop in main.cpp
-    // int my_image_width = 0;
-    // int my_image_height = 0;
-    // GLuint my_image_texture = 0;
-    // bool ret = LoadTextureFromFile(
-    //     "./rise.png", 
-    //     &my_image_texture, 
-    //     &my_image_width, 
-    //     &my_image_height);
-    // IM_ASSERT(ret);
+    // Cached after the first call, a placeholder until it's loaded
+    ManagedTexture logo = textures.Get("../imgs/rise.png");
 
     ImGui::SetNextWindowSize(io.DisplaySize);
     ImGui::SetNextWindowPos(ImVec2(0, 0));
@@ -52,18 +56,36 @@ void MainMenu(
             ImGuiWindowFlags_NoResize |
             ImGuiWindowFlags_NoMove);
 
-    // ImGui::Image(
-    //     (ImTextureID)(intptr_t)my_image_texture, 
-    //     ImVec2(
-    //         my_image_width, 
-    //         my_image_height));
+    // Logo and title are replayed from the previous frame until the logo
+    // loads or the window changes, only the launch button is rebuilt
+    ImU32 header_hash = ImHashData(&logo.id, sizeof(logo.id));
+    header_hash = ImHashData(&logo.width, sizeof(logo.width), header_hash);
+    header_hash = ImHashData(&logo.height, sizeof(logo.height), header_hash);
+    header_hash = ImHashData(&logo.ready, sizeof(logo.ready), header_hash);
+
+    if (ImGui::BeginCachedDraw(
+        &GetMainMenuCache(),
+        header_hash) == true)
+    {
+        // Keep the same footprint while loading so the layout doesn't jump
+        const float logo_size = 128;
+        ImGui::SetCursorPosX((ImGui::GetWindowWidth() - logo_size) / 2);
+        ImGui::Image(
+            logo.TexID(),
+            ImVec2(
+                logo_size,
+                logo.ready == true ?
+                    logo_size * logo.height / logo.width :
+                    logo_size));
 
-    TextAligned(
-        "[LO-RISE]",
-        0.5f,
-        ImVec4(1,1,0,1));
+        TextAligned(
+            "[LO-RISE]",
+            0.5f,
+            ImVec4(1,1,0,1));
 
-    ImGui::NewLine();
+        ImGui::NewLine();
+        ImGui::EndCachedDraw(&GetMainMenuCache());
+    }
 
     // What happens when launch button is pressed
     auto launch_callback = [&show_main_menu, &show_lorise] ()
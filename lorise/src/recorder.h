@@ -0,0 +1,1166 @@
+#pragma once
+
+// Standard library includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// ImGui includes
+#include "imgui.h"
+
+// Lo-RISE includes
+#include "lorise.h"
+#include "utils/mapped_file.h"
+
+/*
+ * Session log format. All values are in host byte order.
+ *
+ *  SessionHeader
+ *  Frame records, back to back:
+ *      uint32 size             Bytes following this field
+ *      uint8 kind              SessionFrameKind
+ *      double time             Seconds since the first frame
+ *      LoRISEView              5 floats, int32 selected tactic, uint8 action
+ *      agents, then tactics:
+ *          key frame:      varint count, then per entity zigzag dx, dy
+ *                          (from the previous entity), uint32 color, uint8 flags,
+ *                          varint name
+ *          delta frame:    varint moved, then per entity varint index gap, zigzag dx, dy
+ *                          (from its last position), then varint changed, then
+ *                          per entity varint index gap, uint32 color, uint8 flags,
+ *                          then varint renamed, then per entity varint index gap,
+ *                          varint name
+ *  Names: per store varint count, then per name varint length and bytes.
+ *         Entities refer to names by their position in this table.
+ *  Frame table: per frame uint64 offset, double time
+ *  Key frame table: per key frame uint32 frame
+ *
+ * Positions are quantized to SESSION_QUANTUM world units. A key frame is
+ * written every keyframe_interval frames and whenever an entity is added,
+ * so seeking only ever decodes one key frame and the deltas after it.
+ */
+
+static const char SESSION_MAGIC[8] = { 'L', 'O', 'R', 'I', 'S', 'R', 'E', 'C' };
+static const uint32_t SESSION_VERSION = 2;
+static const float SESSION_QUANTUM = 1.0f / 16.0f;
+
+enum SessionFrameKind : uint8_t
+{
+    FrameDelta,
+    FrameKey
+};
+
+struct SessionHeader
+{
+    char magic[8];
+    uint32_t version;
+    float quantum;
+    float display_w;                    // Display size the session was recorded at
+    float display_h;
+    uint32_t frame_count;
+    uint32_t keyframe_count;
+    uint64_t names_offset;
+    uint64_t frame_table_offset;
+    uint64_t keyframe_table_offset;
+};
+
+struct SessionFrameEntry
+{
+    uint64_t offset;
+    double time;
+};
+
+static_assert(sizeof(SessionHeader) == 56, "SessionHeader is a file format");
+static_assert(sizeof(SessionFrameEntry) == 16, "SessionFrameEntry is a file format");
+
+static void WriteVarint(
+    std::vector<uint8_t>& out,
+    uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+static void WriteZigzag(
+    std::vector<uint8_t>& out,
+    const int64_t value)
+{
+    WriteVarint(
+        out,
+        ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+template <typename T>
+static void WriteRaw(
+    std::vector<uint8_t>& out,
+    const T& value)
+{
+    const uint8_t* bytes = (const uint8_t*)&value;
+    out.insert(
+        out.end(),
+        bytes,
+        bytes + sizeof(T));
+}
+
+/**
+ * @brief Bounds checked cursor over a mapped session log.
+ * Reading past the end yields zeros and clears ok.
+ */
+struct SessionReader
+{
+    const uint8_t* ptr = NULL;
+    const uint8_t* end = NULL;
+    bool ok = true;
+
+    uint64_t Varint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0;
+            shift < 64;
+            shift += 7)
+        {
+            if (ptr >= end)
+            {
+                ok = false;
+                return 0;
+            }
+
+            uint8_t byte = *ptr++;
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+
+        ok = false;
+        return 0;
+    }
+
+    int64_t Zigzag()
+    {
+        uint64_t value = Varint();
+        return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+    }
+
+    template <typename T>
+    T Raw()
+    {
+        T value;
+        memset(&value, 0, sizeof(T));
+        if ((size_t)(end - ptr) < sizeof(T))
+        {
+            ok = false;
+            ptr = end;
+            return value;
+        }
+
+        memcpy(&value, ptr, sizeof(T));
+        ptr += sizeof(T);
+        return value;
+    }
+};
+
+static int32_t QuantizePos(
+    const float value)
+{
+    return (int32_t)std::lround(value / SESSION_QUANTUM);
+}
+
+static uint8_t PackFlags(
+    const EntityStore& store,
+    const int index)
+{
+    uint8_t bits = 0;
+    for (int ff = 0;
+        ff < EntityStore::FlagCount;
+        ff++)
+    {
+        if (store.GetFlag(index, (EntityStore::Flag)ff) == true)
+        {
+            bits |= (uint8_t)(1 << ff);
+        }
+    }
+
+    return bits;
+}
+
+static void UnpackFlags(
+    EntityStore& store,
+    const int index,
+    const uint8_t bits)
+{
+    for (int ff = 0;
+        ff < EntityStore::FlagCount;
+        ff++)
+    {
+        store.SetFlag(index, (EntityStore::Flag)ff, (bits & (1 << ff)) != 0);
+    }
+}
+
+/**
+ * @brief Writes a session log, one record per frame.
+ * Only what changed since the previous frame is written between key frames.
+ */
+class SessionRecorder
+{
+public:
+    static const int DEFAULT_KEYFRAME_INTERVAL = 120;
+
+    SessionRecorder() = default;
+    SessionRecorder(const SessionRecorder&) = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+
+    ~SessionRecorder()
+    {
+        Close();
+    }
+
+    bool Open(
+        const std::string& path,
+        const ImVec2 display_size,
+        const int interval = DEFAULT_KEYFRAME_INTERVAL)
+    {
+        Close();
+
+        file = fopen(path.c_str(), "wb");
+        if (file == NULL)
+        {
+            fprintf(stderr, "Lo-RISE: can't open session log %s for writing\n", path.c_str());
+            return false;
+        }
+
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, SESSION_MAGIC, sizeof(header.magic));
+        header.version = SESSION_VERSION;
+        header.quantum = SESSION_QUANTUM;
+        header.display_w = display_size.x;
+        header.display_h = display_size.y;
+        fwrite(&header, sizeof(header), 1, file);
+
+        keyframe_interval = std::max(interval, 1);
+        offset = sizeof(header);
+        start_time = -1;
+        frames.clear();
+        keyframes.clear();
+        stores[0] = StoreShadow();
+        stores[1] = StoreShadow();
+        return true;
+    }
+
+    bool IsOpen() const
+    {
+        return file != NULL;
+    }
+
+    /**
+     * @brief Append the view and entities as drawn this frame.
+     */
+    void RecordFrame(
+        const double time,
+        const LoRISEView& view,
+        const LoRISEState& state)
+    {
+        if (file == NULL)
+        {
+            return;
+        }
+
+        if (start_time < 0)
+        {
+            start_time = time;
+        }
+
+        const EntityStore* sources[2] = {
+            &state.agents,
+            &state.tactics };
+
+        bool key = frames.size() % keyframe_interval == 0;
+        for (int ss = 0;
+            ss < 2;
+            ss++)
+        {
+            key = key || sources[ss]->Size() != (int)stores[ss].qx.size();
+        }
+
+        record.clear();
+        WriteRaw(record, (uint32_t)0);
+        WriteRaw(record, (uint8_t)(key == true ? FrameKey : FrameDelta));
+        WriteRaw(record, time - start_time);
+        WriteRaw(record, view.camera_pan.x);
+        WriteRaw(record, view.camera_pan.y);
+        WriteRaw(record, view.camera_zoom);
+        WriteRaw(record, view.tactic_drag.x);
+        WriteRaw(record, view.tactic_drag.y);
+        WriteRaw(record, (int32_t)view.selected_tactic);
+        WriteRaw(record, (uint8_t)view.current_action);
+
+        for (int ss = 0;
+            ss < 2;
+            ss++)
+        {
+            if (key == true)
+            {
+                WriteKeyStore(
+                    *sources[ss],
+                    stores[ss]);
+            }
+            else
+            {
+                WriteDeltaStore(
+                    *sources[ss],
+                    stores[ss]);
+            }
+        }
+
+        uint32_t size = (uint32_t)(record.size() - sizeof(uint32_t));
+        memcpy(record.data(), &size, sizeof(size));
+
+        SessionFrameEntry entry;
+        entry.offset = offset;
+        entry.time = time - start_time;
+        if (key == true)
+        {
+            keyframes.push_back((uint32_t)frames.size());
+        }
+        frames.push_back(entry);
+
+        fwrite(record.data(), 1, record.size(), file);
+        offset += record.size();
+    }
+
+    /**
+     * @brief Write the names and seek tables, then finalize the header.
+     */
+    void Close()
+    {
+        if (file == NULL)
+        {
+            return;
+        }
+
+        record.clear();
+        for (int ss = 0;
+            ss < 2;
+            ss++)
+        {
+            const std::vector<std::string>& names = stores[ss].names.names;
+            WriteVarint(record, names.size());
+            for (const std::string& name : names)
+            {
+                WriteVarint(record, name.size());
+                record.insert(
+                    record.end(),
+                    name.begin(),
+                    name.end());
+            }
+        }
+
+        header.names_offset = offset;
+        offset += record.size();
+        header.frame_table_offset = offset;
+        offset += frames.size() * sizeof(SessionFrameEntry);
+        header.keyframe_table_offset = offset;
+        header.frame_count = (uint32_t)frames.size();
+        header.keyframe_count = (uint32_t)keyframes.size();
+
+        fwrite(record.data(), 1, record.size(), file);
+        fwrite(frames.data(), sizeof(SessionFrameEntry), frames.size(), file);
+        fwrite(keyframes.data(), sizeof(uint32_t), keyframes.size(), file);
+
+        fseek(file, 0, SEEK_SET);
+        fwrite(&header, sizeof(header), 1, file);
+        fclose(file);
+        file = NULL;
+    }
+
+private:
+    /**
+     * @brief What the log says an entity store looks like so far.
+     */
+    struct StoreShadow
+    {
+        std::vector<int32_t> qx;            // Quantized positions
+        std::vector<int32_t> qy;
+        std::vector<ImU32> color;
+        std::vector<uint8_t> flags;
+        std::vector<NameHandle> name;       // Handle into names
+        std::vector<NameHandle> store_name; // Handle in the store's own table, to spot renames
+        NameTable names;                    // Every name ever recorded, written on close
+        std::vector<uint32_t> moved;        // Scratch, entities written this frame
+        std::vector<uint32_t> changed;
+        std::vector<uint32_t> renamed;
+    };
+
+    FILE* file = NULL;
+    SessionHeader header;
+    int keyframe_interval = DEFAULT_KEYFRAME_INTERVAL;
+    uint64_t offset = 0;
+    double start_time = -1;
+    std::vector<SessionFrameEntry> frames;
+    std::vector<uint32_t> keyframes;
+    std::vector<uint8_t> record;            // Scratch, the frame being encoded
+    StoreShadow stores[2];                  // Agents, tactics
+
+    void WriteKeyStore(
+        const EntityStore& store,
+        StoreShadow& shadow)
+    {
+        int count = store.Size();
+        shadow.qx.resize(count);
+        shadow.qy.resize(count);
+        shadow.color.resize(count);
+        shadow.flags.resize(count);
+        shadow.name.resize(count);
+        shadow.store_name.resize(count);
+
+        WriteVarint(record, (uint64_t)count);
+
+        int32_t prev_x = 0;
+        int32_t prev_y = 0;
+        for (int ii = 0;
+            ii < count;
+            ii++)
+        {
+            shadow.qx[ii] = QuantizePos(store.x[ii]);
+            shadow.qy[ii] = QuantizePos(store.y[ii]);
+            shadow.color[ii] = store.color[ii];
+            shadow.flags[ii] = PackFlags(store, ii);
+
+            // Looked up by string, the store may not be the one the handles came from
+            shadow.name[ii] = shadow.names.Intern(store.GetName(ii));
+            shadow.store_name[ii] = store.name[ii];
+
+            WriteZigzag(record, (int64_t)shadow.qx[ii] - prev_x);
+            WriteZigzag(record, (int64_t)shadow.qy[ii] - prev_y);
+            WriteRaw(record, shadow.color[ii]);
+            WriteRaw(record, shadow.flags[ii]);
+            WriteVarint(record, shadow.name[ii]);
+            prev_x = shadow.qx[ii];
+            prev_y = shadow.qy[ii];
+        }
+    }
+
+    void WriteDeltaStore(
+        const EntityStore& store,
+        StoreShadow& shadow)
+    {
+        int count = store.Size();
+        shadow.moved.clear();
+        shadow.changed.clear();
+        shadow.renamed.clear();
+
+        for (int ii = 0;
+            ii < count;
+            ii++)
+        {
+            if (QuantizePos(store.x[ii]) != shadow.qx[ii] ||
+                QuantizePos(store.y[ii]) != shadow.qy[ii])
+            {
+                shadow.moved.push_back((uint32_t)ii);
+            }
+
+            if (store.color[ii] != shadow.color[ii] ||
+                PackFlags(store, ii) != shadow.flags[ii])
+            {
+                shadow.changed.push_back((uint32_t)ii);
+            }
+
+            // Renamed, or a removed slot reused for a new entity
+            if (store.name[ii] != shadow.store_name[ii])
+            {
+                shadow.renamed.push_back((uint32_t)ii);
+            }
+        }
+
+        WriteVarint(record, shadow.moved.size());
+        uint32_t next = 0;
+        for (uint32_t index : shadow.moved)
+        {
+            int32_t qx = QuantizePos(store.x[index]);
+            int32_t qy = QuantizePos(store.y[index]);
+
+            WriteVarint(record, index - next);
+            WriteZigzag(record, (int64_t)qx - shadow.qx[index]);
+            WriteZigzag(record, (int64_t)qy - shadow.qy[index]);
+            shadow.qx[index] = qx;
+            shadow.qy[index] = qy;
+            next = index + 1;
+        }
+
+        WriteVarint(record, shadow.changed.size());
+        next = 0;
+        for (uint32_t index : shadow.changed)
+        {
+            shadow.color[index] = store.color[index];
+            shadow.flags[index] = PackFlags(store, index);
+
+            WriteVarint(record, index - next);
+            WriteRaw(record, shadow.color[index]);
+            WriteRaw(record, shadow.flags[index]);
+            next = index + 1;
+        }
+
+        WriteVarint(record, shadow.renamed.size());
+        next = 0;
+        for (uint32_t index : shadow.renamed)
+        {
+            shadow.name[index] = shadow.names.Intern(store.GetName(index));
+            shadow.store_name[index] = store.name[index];
+
+            WriteVarint(record, index - next);
+            WriteVarint(record, shadow.name[index]);
+            next = index + 1;
+        }
+    }
+};
+
+/**
+ * @brief Plays a session log back into a LoRISEState at any speed.
+ * The log is memory-mapped; seeking decodes the nearest key frame
+ * before the target and the deltas that follow it.
+ */
+class SessionPlayer
+{
+public:
+    bool Open(
+        const std::string& path)
+    {
+        current_frame = -1;
+        time = 0;
+
+        if (file.Open(path.c_str()) == false ||
+            file.Size() < sizeof(SessionHeader))
+        {
+            fprintf(stderr, "Lo-RISE: can't open session log %s\n", path.c_str());
+            return false;
+        }
+
+        memcpy(&header, file.Data(), sizeof(header));
+        uint64_t frames_end = header.frame_table_offset + (uint64_t)header.frame_count * sizeof(SessionFrameEntry);
+        uint64_t keyframes_end = header.keyframe_table_offset + (uint64_t)header.keyframe_count * sizeof(uint32_t);
+        if (memcmp(header.magic, SESSION_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != SESSION_VERSION ||
+            header.frame_count == 0 ||
+            header.keyframe_count == 0 ||
+            header.names_offset > header.frame_table_offset ||
+            frames_end > header.keyframe_table_offset ||
+            keyframes_end > file.Size())
+        {
+            fprintf(stderr, "Lo-RISE: %s is not a complete session log\n", path.c_str());
+            file.Close();
+            return false;
+        }
+
+        if (ValidTables() == false)
+        {
+            fprintf(stderr, "Lo-RISE: %s has a corrupt frame or key frame table\n", path.c_str());
+            file.Close();
+            return false;
+        }
+
+        SessionReader reader = Reader(header.names_offset, header.frame_table_offset);
+        for (int ss = 0;
+            ss < 2;
+            ss++)
+        {
+            uint64_t count = reader.Varint();
+            if (count > (uint64_t)(reader.end - reader.ptr))
+            {
+                // Every name takes at least its length byte
+                reader.ok = false;
+                break;
+            }
+
+            names[ss].resize((size_t)count);
+            for (std::string& name : names[ss])
+            {
+                size_t length = (size_t)reader.Varint();
+                if ((size_t)(reader.end - reader.ptr) < length)
+                {
+                    reader.ok = false;
+                    break;
+                }
+
+                name.assign((const char*)reader.ptr, length);
+                reader.ptr += length;
+            }
+        }
+
+        if (reader.ok == false)
+        {
+            fprintf(stderr, "Lo-RISE: %s has a corrupt name table\n", path.c_str());
+            file.Close();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool IsOpen() const
+    {
+        return file.Data() != NULL;
+    }
+
+    int FrameCount() const
+    {
+        return (int)header.frame_count;
+    }
+
+    double Duration() const
+    {
+        return Frame(FrameCount() - 1).time;
+    }
+
+    double Time() const
+    {
+        return time;
+    }
+
+    ImVec2 DisplaySize() const
+    {
+        return ImVec2(
+            header.display_w,
+            header.display_h);
+    }
+
+    /**
+     * @brief View recorded with the current frame.
+     */
+    const LoRISEView& View() const
+    {
+        return view;
+    }
+
+    /**
+     * @brief Move playback forward by dt seconds scaled by speed.
+     * Negative speeds play backwards.
+     */
+    void Advance(
+        LoRISEState& state,
+        const double dt,
+        const double speed)
+    {
+        Seek(
+            state,
+            time + dt * speed);
+    }
+
+    /**
+     * @brief Jump to the last frame at or before the given time.
+     */
+    void Seek(
+        LoRISEState& state,
+        const double target_time)
+    {
+        if (IsOpen() == false)
+        {
+            return;
+        }
+
+        time = std::min(std::max(target_time, 0.0), Duration());
+
+        // Last frame at or before the target
+        int lo = 0;
+        int hi = FrameCount() - 1;
+        while (lo < hi)
+        {
+            int mid = (lo + hi + 1) / 2;
+            if (Frame(mid).time <= time)
+            {
+                lo = mid;
+            }
+            else
+            {
+                hi = mid - 1;
+            }
+        }
+
+        SeekFrame(
+            state,
+            lo);
+    }
+
+    /**
+     * @brief Make the given frame current. Stepping forward decodes only
+     * the frames in between, anything else restarts from a key frame.
+     * After a jump back, or ahead by more than agents glide, agents are
+     * put straight at their positions and their trails start over.
+     */
+    void SeekFrame(
+        LoRISEState& state,
+        const int frame)
+    {
+        if (frame == current_frame ||
+            frame < 0 ||
+            frame >= FrameCount())
+        {
+            return;
+        }
+
+        // Playback stepping forward, even several frames at high speeds, stays
+        // continuous; going back or skipping ahead further than agents glide is a jump
+        bool jump = current_frame < 0 ||
+            frame < current_frame ||
+            Frame(frame).time - Frame(current_frame).time > MotionSmoother::MAX_DURATION;
+
+        int key = KeyframeBefore(frame);
+        if (frame < current_frame ||
+            key > current_frame)
+        {
+            for (int ff = key;
+                ff <= frame;
+                ff++)
+            {
+                DecodeFrame(
+                    state,
+                    ff,
+                    false);
+            }
+
+            IndexEntities(state);
+        }
+        else
+        {
+            for (int ff = current_frame + 1;
+                ff <= frame;
+                ff++)
+            {
+                DecodeFrame(
+                    state,
+                    ff,
+                    true);
+            }
+        }
+
+        // Gliding or trailing from before a jump would show paths never taken
+        if (jump == true)
+        {
+            for (int ii = 0;
+                ii < state.agents.Size();
+                ii++)
+            {
+                state.trails.Clear(ii);
+                state.agent_motion.Snap(
+                    ii,
+                    state.agents.x[ii],
+                    state.agents.y[ii]);
+            }
+        }
+
+        current_frame = frame;
+    }
+
+private:
+    MappedFile file;
+    SessionHeader header;
+    std::vector<std::string> names[2];      // Agents, tactics
+    int current_frame = -1;
+    double time = 0;
+    LoRISEView view;
+
+    /**
+     * @brief Check the tables Frame() and KeyframeBefore() index into:
+     * frame records must follow each other between the header and the
+     * name table, and key frames must be increasing frames, starting at 0.
+     */
+    bool ValidTables() const
+    {
+        if (header.frame_count > (uint32_t)INT32_MAX)
+        {
+            return false;
+        }
+
+        uint64_t previous = sizeof(SessionHeader);
+        for (int ff = 0;
+            ff < FrameCount();
+            ff++)
+        {
+            uint64_t offset = Frame(ff).offset;
+            if (offset < previous ||
+                (ff > 0 && offset == previous) ||
+                offset > header.names_offset)
+            {
+                return false;
+            }
+            previous = offset;
+        }
+
+        const uint8_t* table = file.Data() + header.keyframe_table_offset;
+        uint32_t previous_key = 0;
+        for (uint32_t kk = 0;
+            kk < header.keyframe_count;
+            kk++)
+        {
+            uint32_t key;
+            memcpy(&key, table + kk * sizeof(uint32_t), sizeof(key));
+            if (key >= header.frame_count ||
+                (kk == 0 && key != 0) ||
+                (kk > 0 && key <= previous_key))
+            {
+                return false;
+            }
+            previous_key = key;
+        }
+
+        return true;
+    }
+
+    SessionReader Reader(
+        const uint64_t begin,
+        const uint64_t end) const
+    {
+        SessionReader reader;
+        reader.ptr = file.Data() + begin;
+        reader.end = file.Data() + end;
+        return reader;
+    }
+
+    SessionFrameEntry Frame(
+        const int frame) const
+    {
+        SessionFrameEntry entry;
+        memcpy(
+            &entry,
+            file.Data() + header.frame_table_offset + (uint64_t)frame * sizeof(SessionFrameEntry),
+            sizeof(entry));
+        return entry;
+    }
+
+    int KeyframeBefore(
+        const int frame) const
+    {
+        const uint8_t* table = file.Data() + header.keyframe_table_offset;
+        int lo = 0;
+        int hi = (int)header.keyframe_count - 1;
+        while (lo < hi)
+        {
+            int mid = (lo + hi + 1) / 2;
+            uint32_t key;
+            memcpy(&key, table + mid * sizeof(uint32_t), sizeof(key));
+            if ((int)key <= frame)
+            {
+                lo = mid;
+            }
+            else
+            {
+                hi = mid - 1;
+            }
+        }
+
+        uint32_t key;
+        memcpy(&key, table + lo * sizeof(uint32_t), sizeof(key));
+        return (int)key;
+    }
+
+    /**
+     * @brief Apply one frame record. Spatial indices are updated
+     * per entity when update_index is set, otherwise the caller
+     * rebuilds them once after decoding.
+     */
+    void DecodeFrame(
+        LoRISEState& state,
+        const int frame,
+        const bool update_index)
+    {
+        uint64_t begin = Frame(frame).offset;
+        uint64_t end = frame + 1 < FrameCount() ?
+            Frame(frame + 1).offset :
+            header.names_offset;
+
+        SessionReader reader = Reader(begin, end);
+        reader.Raw<uint32_t>();
+        uint8_t kind = reader.Raw<uint8_t>();
+        reader.Raw<double>();
+
+        view.camera_pan.x = reader.Raw<float>();
+        view.camera_pan.y = reader.Raw<float>();
+        view.camera_zoom = reader.Raw<float>();
+        view.tactic_drag.x = reader.Raw<float>();
+        view.tactic_drag.y = reader.Raw<float>();
+        view.selected_tactic = reader.Raw<int32_t>();
+        view.current_action = (Action)reader.Raw<uint8_t>();
+
+        EntityStore* stores[2] = {
+            &state.agents,
+            &state.tactics };
+
+        for (int ss = 0;
+            ss < 2 && reader.ok == true;
+            ss++)
+        {
+            if (kind == FrameKey)
+            {
+                DecodeKeyStore(
+                    reader,
+                    *stores[ss],
+                    names[ss]);
+            }
+            else
+            {
+                DecodeDeltaStore(
+                    reader,
+                    state,
+                    ss,
+                    update_index);
+            }
+        }
+
+        if (kind == FrameKey &&
+            update_index == true)
+        {
+            IndexEntities(state);
+        }
+
+        if (view.selected_tactic >= state.tactics.Size())
+        {
+            view.selected_tactic = -1;
+            view.current_action = Action::Idle;
+        }
+    }
+
+    void DecodeKeyStore(
+        SessionReader& reader,
+        EntityStore& store,
+        const std::vector<std::string>& store_names)
+    {
+        int count = (int)std::min(reader.Varint(), (uint64_t)INT32_MAX);
+        if ((uint64_t)count > (uint64_t)(reader.end - reader.ptr))
+        {
+            // Every entity takes more than a byte, so this can't be a real count
+            reader.ok = false;
+            return;
+        }
+
+        if (count != store.Size())
+        {
+            store = EntityStore();
+            store.Reserve(count);
+            for (int ii = 0;
+                ii < count;
+                ii++)
+            {
+                store.Add(
+                    "",
+                    ImVec2(0, 0),
+                    0);
+            }
+        }
+
+        int64_t qx = 0;
+        int64_t qy = 0;
+        for (int ii = 0;
+            ii < count && reader.ok == true;
+            ii++)
+        {
+            qx += reader.Zigzag();
+            qy += reader.Zigzag();
+            store.x[ii] = (float)qx * SESSION_QUANTUM;
+            store.y[ii] = (float)qy * SESSION_QUANTUM;
+            store.color[ii] = reader.Raw<ImU32>();
+            UnpackFlags(store, ii, reader.Raw<uint8_t>());
+            ApplyName(
+                reader,
+                store,
+                ii,
+                store_names);
+        }
+    }
+
+    /**
+     * @brief Read a name reference and rename the entity if it differs,
+     * so a store kept across key frames never holds stale names.
+     */
+    static void ApplyName(
+        SessionReader& reader,
+        EntityStore& store,
+        const int index,
+        const std::vector<std::string>& store_names)
+    {
+        uint64_t name = reader.Varint();
+        if (name >= store_names.size())
+        {
+            reader.ok = false;
+            return;
+        }
+
+        if (store_names[name] != store.GetName(index))
+        {
+            store.SetName(
+                index,
+                store_names[name]);
+        }
+    }
+
+    void DecodeDeltaStore(
+        SessionReader& reader,
+        LoRISEState& state,
+        const int store_index,
+        const bool update_index)
+    {
+        EntityStore& store = store_index == 0 ?
+            state.agents :
+            state.tactics;
+
+        uint64_t moved = reader.Varint();
+        uint64_t next = 0;
+        for (uint64_t ii = 0;
+            ii < moved && reader.ok == true;
+            ii++)
+        {
+            uint64_t index = next + reader.Varint();
+            int64_t dx = reader.Zigzag();
+            int64_t dy = reader.Zigzag();
+            next = index + 1;
+            if (index >= (uint64_t)store.Size())
+            {
+                reader.ok = false;
+                return;
+            }
+
+            // Positions were quantized on write, so the sum is exact
+            ImVec2 pos = ImVec2(
+                (float)(QuantizePos(store.x[index]) + dx) * SESSION_QUANTUM,
+                (float)(QuantizePos(store.y[index]) + dy) * SESSION_QUANTUM);
+
+            if (update_index == false)
+            {
+                store.SetPos((int)index, pos);
+            }
+            else if (store_index == 0)
+            {
+                MoveAgent(state, (int)index, pos);
+            }
+            else
+            {
+                MoveTactic(state, (int)index, pos);
+            }
+        }
+
+        uint64_t changed = reader.Varint();
+        next = 0;
+        for (uint64_t ii = 0;
+            ii < changed && reader.ok == true;
+            ii++)
+        {
+            uint64_t index = next + reader.Varint();
+            ImU32 color = reader.Raw<ImU32>();
+            uint8_t flags = reader.Raw<uint8_t>();
+            next = index + 1;
+            if (index >= (uint64_t)store.Size())
+            {
+                reader.ok = false;
+                return;
+            }
+
+            bool was_live = store.IsLive((int)index);
+            store.color[index] = color;
+            UnpackFlags(store, (int)index, flags);
+
+            // Entities removed or reinserted since the last frame
+            if (update_index == true &&
+                store.IsLive((int)index) != was_live)
+            {
+                SpatialIndex& spatial_index = store_index == 0 ?
+                    state.agent_index :
+                    state.tactic_index;
+
+                if (was_live == true)
+                {
+                    spatial_index.Remove((int)index);
+                }
+                else
+                {
+                    spatial_index.Insert((int)index, store.GetPos((int)index));
+                }
+            }
+        }
+
+        uint64_t renamed = reader.Varint();
+        next = 0;
+        for (uint64_t ii = 0;
+            ii < renamed && reader.ok == true;
+            ii++)
+        {
+            uint64_t index = next + reader.Varint();
+            next = index + 1;
+            if (index >= (uint64_t)store.Size())
+            {
+                reader.ok = false;
+                return;
+            }
+
+            ApplyName(
+                reader,
+                store,
+                (int)index,
+                names[store_index]);
+        }
+    }
+};
+
+/**
+ * @brief Small window to pause, scrub and change the speed of playback.
+ * Call once per frame before drawing the view, returns true while playing.
+ */
+bool PlaybackControls(
+    SessionPlayer& player,
+    LoRISEState& state,
+    const ImGuiIO& io,
+    float& speed,
+    bool& paused)
+{
+    if (player.IsOpen() == false)
+    {
+        return false;
+    }
+
+    ImGui::SetNextWindowPos(
+        ImVec2(10, io.DisplaySize.y - 10),
+        ImGuiCond_FirstUseEver,
+        ImVec2(0, 1));
+
+    ImGui::Begin(
+        "Playback",
+        NULL,
+        ImGuiWindowFlags_AlwaysAutoResize);
+
+    if (ImGui::Button(paused == true ? "Play" : "Pause"))
+    {
+        paused = !paused;
+    }
+
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(120);
+    ImGui::SliderFloat("Speed", &speed, -8.0f, 8.0f, "%.2fx");
+
+    float time = (float)player.Time();
+    ImGui::SetNextItemWidth(360);
+    bool scrubbed = ImGui::SliderFloat("Time", &time, 0.0f, (float)player.Duration(), "%.2f s");
+    ImGui::End();
+
+    if (scrubbed == true)
+    {
+        player.Seek(
+            state,
+            time);
+    }
+    else if (paused == false)
+    {
+        player.Advance(
+            state,
+            io.DeltaTime,
+            speed);
+    }
+
+    return paused == false;
+}
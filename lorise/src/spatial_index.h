@@ -0,0 +1,315 @@
+#pragma once
+
+// Standard library includes
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// ImGui includes
+#include "imgui.h"
+
+/**
+ * @brief World-space uniform grid over entity positions.
+ * Entities are referred to by their index in the owning container.
+ * Cells are hashed so the world does not need fixed bounds.
+ */
+struct SpatialIndex
+{
+    static constexpr float DEFAULT_CELL_SIZE = 100.0f;
+
+    float cell_size = DEFAULT_CELL_SIZE;
+    std::unordered_map<int64_t, std::vector<int>> cells;   // Cell key -> entity indices in that cell
+    std::vector<int64_t> entity_cells;                      // Entity index -> cell key it is stored in, or NO_CELL
+
+    static const int64_t NO_CELL = INT64_MIN;               // CellKey(INT32_MIN, 0), far outside any world
+
+    static constexpr float MAX_CELL_COORD = 1 << 30;       // Keeps cell spans and keys clear of int overflow
+
+    /**
+     * @brief Cell coordinate containing the given world coordinate.
+     * Clamped, since casting a float outside the int range is undefined.
+     */
+    int CellCoord(
+        const float world) const
+    {
+        float cell = std::floor(world / cell_size);
+        if ((cell >= -MAX_CELL_COORD) == false)
+        {
+            return -(int)MAX_CELL_COORD;
+        }
+        if (cell > MAX_CELL_COORD)
+        {
+            return (int)MAX_CELL_COORD;
+        }
+
+        return (int)cell;
+    }
+
+    /**
+     * @brief Pack a cell coordinate pair into a single hash key.
+     */
+    static int64_t CellKey(
+        const int cx,
+        const int cy)
+    {
+        return ((int64_t)cx << 32) | (int64_t)(uint32_t)cy;
+    }
+
+    /**
+     * @brief Remove every entity from the index.
+     */
+    void Clear()
+    {
+        cells.clear();
+        entity_cells.clear();
+    }
+
+    /**
+     * @brief Add an entity to the index. Indices are expected
+     * to be added in order, matching the owning container,
+     * or to have been taken out with Remove(). An index already
+     * in the index is moved rather than stored twice.
+     */
+    void Insert(
+        const int index,
+        const ImVec2 pos)
+    {
+        if (index >= (int)entity_cells.size())
+        {
+            // Copied, resize() taking NO_CELL by reference would need it defined out of class
+            entity_cells.resize(index + 1, (int64_t)NO_CELL);
+        }
+        else if (entity_cells[index] != NO_CELL)
+        {
+            RemoveFromCell(
+                entity_cells[index],
+                index);
+        }
+
+        int64_t key = CellKey(
+            CellCoord(pos.x),
+            CellCoord(pos.y));
+
+        entity_cells[index] = key;
+        cells[key].push_back(index);
+    }
+
+    /**
+     * @brief Take an entity out of the index, e.g. when it is removed.
+     * It can be added back with Insert().
+     */
+    void Remove(
+        const int index)
+    {
+        if (index >= (int)entity_cells.size() ||
+            entity_cells[index] == NO_CELL)
+        {
+            return;
+        }
+
+        RemoveFromCell(
+            entity_cells[index],
+            index);
+
+        entity_cells[index] = NO_CELL;
+    }
+
+    /**
+     * @brief Update an entity after its position changed.
+     * Only touches the index if the entity crossed into a new cell.
+     * Entities not in the index are left out.
+     */
+    void Move(
+        const int index,
+        const ImVec2 pos)
+    {
+        if (index < 0 ||
+            index >= (int)entity_cells.size())
+        {
+            return;
+        }
+
+        int64_t key = CellKey(
+            CellCoord(pos.x),
+            CellCoord(pos.y));
+
+        int64_t old_key = entity_cells[index];
+        if (key == old_key ||
+            old_key == NO_CELL)
+        {
+            return;
+        }
+
+        RemoveFromCell(
+            old_key,
+            index);
+
+        entity_cells[index] = key;
+        cells[key].push_back(index);
+    }
+
+    /**
+     * @brief Rebuild the index from packed entity positions.
+     */
+    void Build(
+        const float* xs,
+        const float* ys,
+        const int count)
+    {
+        Clear();
+        entity_cells.reserve(count);
+
+        for (int ii = 0;
+            ii < count;
+            ii++)
+        {
+            Insert(
+                ii,
+                ImVec2(xs[ii], ys[ii]));
+        }
+    }
+
+    /**
+     * @brief Visit every entity stored in a cell overlapping the world-space
+     * circle. Candidates still need an exact distance test by the caller.
+     */
+    template <typename Visitor>
+    void QueryRadius(
+        const ImVec2 pos,
+        const float radius,
+        Visitor&& visit) const
+    {
+        int cx_min = CellCoord(pos.x - radius);
+        int cx_max = CellCoord(pos.x + radius);
+        int cy_min = CellCoord(pos.y - radius);
+        int cy_max = CellCoord(pos.y + radius);
+
+        for (int cx = cx_min;
+            cx <= cx_max;
+            cx++)
+        {
+            for (int cy = cy_min;
+                cy <= cy_max;
+                cy++)
+            {
+                auto it = cells.find(CellKey(cx, cy));
+                if (it == cells.end())
+                {
+                    continue;
+                }
+
+                for (int index : it->second)
+                {
+                    visit(index);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Visit every entity stored in a cell overlapping the world-space
+     * rectangle. Candidates still need an exact bounds test by the caller.
+     */
+    template <typename Visitor>
+    void QueryRect(
+        const ImVec2 min,
+        const ImVec2 max,
+        Visitor&& visit) const
+    {
+        QueryCells(
+            min,
+            max,
+            [&](int, int, const std::vector<int>& bucket)
+            {
+                for (int index : bucket)
+                {
+                    visit(index);
+                }
+            });
+    }
+
+    /**
+     * @brief Call visit(cx, cy, entity indices) for every occupied cell
+     * overlapping the world-space rectangle. The indices may be empty.
+     */
+    template <typename Visitor>
+    void QueryCells(
+        const ImVec2 min,
+        const ImVec2 max,
+        Visitor&& visit) const
+    {
+        int cx_min = CellCoord(min.x);
+        int cx_max = CellCoord(max.x);
+        int cy_min = CellCoord(min.y);
+        int cy_max = CellCoord(max.y);
+
+        // A huge rect over a sparse world is cheaper to
+        // answer by walking the occupied cells instead
+        if (((int64_t)cx_max - cx_min + 1) * ((int64_t)cy_max - cy_min + 1) > (int64_t)cells.size())
+        {
+            for (const auto& cell : cells)
+            {
+                int cx = (int)(cell.first >> 32);
+                int cy = (int)(uint32_t)cell.first;
+                if (cx < cx_min || cx > cx_max ||
+                    cy < cy_min || cy > cy_max)
+                {
+                    continue;
+                }
+
+                visit(cx, cy, cell.second);
+            }
+            return;
+        }
+
+        for (int cx = cx_min;
+            cx <= cx_max;
+            cx++)
+        {
+            for (int cy = cy_min;
+                cy <= cy_max;
+                cy++)
+            {
+                auto it = cells.find(CellKey(cx, cy));
+                if (it == cells.end())
+                {
+                    continue;
+                }
+
+                visit(cx, cy, it->second);
+            }
+        }
+    }
+
+private:
+    void RemoveFromCell(
+        const int64_t key,
+        const int index)
+    {
+        auto it = cells.find(key);
+        if (it == cells.end())
+        {
+            return;
+        }
+
+        // Order within a cell doesn't matter, swap and pop
+        std::vector<int>& bucket = it->second;
+        for (size_t ii = 0;
+            ii < bucket.size();
+            ii++)
+        {
+            if (bucket[ii] == index)
+            {
+                bucket[ii] = bucket.back();
+                bucket.pop_back();
+                break;
+            }
+        }
+
+        if (bucket.empty() == true)
+        {
+            cells.erase(it);
+        }
+    }
+};
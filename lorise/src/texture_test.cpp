@@ -0,0 +1,341 @@
+// Lo-RISE texture manager test
+// (runs TextureManager against stubbed GL entry points, so no window or GL context is needed)
+// Only the GLFW headers are needed to build it, not the library.
+//
+// Usage: make test (builds lorise_texture_test.out and runs it)
+//
+// Each case loads encoded images from memory and releases slots while their
+// loads are in flight, then checks every texture still requested gets ready.
+// Images are generated PNGs of a few kilobytes that inflate to 16 MB, so a decode
+// reliably outlasts the sleeps used to order the worker threads.
+
+// Standard library includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+// Lo-RISE includes
+#include "utils/texture_manager.h"
+
+// GL and GLFW entry points the texture manager uses, as no-ops
+static GLuint g_next_texture = 1;
+
+extern "C"
+{
+void glGenTextures(GLsizei n, GLuint* textures) { for (int ii = 0; ii < n; ii++) textures[ii] = g_next_texture++; }
+void glDeleteTextures(GLsizei, const GLuint*) {}
+void glBindTexture(GLenum, GLuint) {}
+void glTexParameteri(GLenum, GLenum, GLint) {}
+void glPixelStorei(GLenum, GLint) {}
+void glTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*) {}
+void glTexSubImage2D(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const void*) {}
+}
+
+// Linkage as declared by glfw3.h
+GLFWglproc glfwGetProcAddress(const char*) { return NULL; }    // No pixel buffer objects
+
+static std::atomic<int> g_decodes_done{0};
+
+static void CountDecode()
+{
+    g_decodes_done++;
+}
+
+/**
+ * @brief Append bits to a deflate stream, least significant first.
+ */
+struct BitWriter
+{
+    std::vector<unsigned char>& out;
+    uint32_t bits = 0;
+    int count = 0;
+
+    explicit BitWriter(
+        std::vector<unsigned char>& stream)
+        : out(stream)
+    {
+    }
+
+    void Put(
+        const uint32_t value,
+        const int length)
+    {
+        bits |= value << count;
+        count += length;
+        while (count >= 8)
+        {
+            out.push_back((unsigned char)bits);
+            bits >>= 8;
+            count -= 8;
+        }
+    }
+
+    // Huffman codes are stored most significant bit first
+    void PutCode(
+        const uint32_t code,
+        const int length)
+    {
+        uint32_t reversed = 0;
+        for (int ii = 0;
+            ii < length;
+            ii++)
+        {
+            reversed |= ((code >> ii) & 1) << (length - 1 - ii);
+        }
+        Put(reversed, length);
+    }
+
+    void Flush()
+    {
+        if (count > 0)
+        {
+            out.push_back((unsigned char)bits);
+        }
+        bits = 0;
+        count = 0;
+    }
+};
+
+static void PutBigEndian(
+    std::vector<unsigned char>& out,
+    const uint32_t value)
+{
+    out.push_back((unsigned char)(value >> 24));
+    out.push_back((unsigned char)(value >> 16));
+    out.push_back((unsigned char)(value >> 8));
+    out.push_back((unsigned char)value);
+}
+
+static void PutChunk(
+    std::vector<unsigned char>& png,
+    const char* type,
+    const std::vector<unsigned char>& data)
+{
+    PutBigEndian(png, (uint32_t)data.size());
+    size_t start = png.size();
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), data.begin(), data.end());
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t ii = start;
+        ii < png.size();
+        ii++)
+    {
+        crc ^= png[ii];
+        for (int bit = 0;
+            bit < 8;
+            bit++)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+    }
+    PutBigEndian(png, crc ^ 0xFFFFFFFFu);
+}
+
+/**
+ * @brief A size x size RGBA PNG, every byte the same value (below 144,
+ * which have 8-bit fixed codes), compressed as one long run per row.
+ * It is a few kilobytes yet inflates to size^2 * 4 bytes.
+ */
+static std::vector<unsigned char> MakeRunPng(
+    const int size,
+    const unsigned char value)
+{
+    std::vector<unsigned char> header;
+    PutBigEndian(header, (uint32_t)size);
+    PutBigEndian(header, (uint32_t)size);
+    const unsigned char format[5] = { 8, 6, 0, 0, 0 };  // 8-bit RGBA, no interlace
+    header.insert(header.end(), format, format + 5);
+
+    // Every row is filter byte 0 then its pixels, so only the first is a different byte
+    std::vector<unsigned char> zlib = { 0x78, 0x01 };
+    BitWriter writer(zlib);
+    writer.Put(1, 1);                                   // Final block
+    writer.Put(1, 2);                                   // Fixed Huffman codes
+
+    uint32_t adler_a = 1;
+    uint32_t adler_b = 0;
+    for (int row = 0;
+        row < size;
+        row++)
+    {
+        // Filter byte and first pixel byte as literals, the rest of the row as matches at distance 1
+        writer.PutCode(0x30, 8);
+        writer.PutCode(0x30 + value, 8);
+        int run = size * 4 - 1;
+        while (run >= 258)
+        {
+            writer.PutCode(0xC5, 8);                    // Length 258
+            writer.PutCode(0, 5);                       // Distance 1
+            run -= 258;
+        }
+        for (int ii = 0;
+            ii < run;
+            ii++)
+        {
+            writer.PutCode(0x30 + value, 8);
+        }
+
+        adler_b = (adler_b + adler_a) % 65521;
+        for (int ii = 0;
+            ii < size * 4;
+            ii++)
+        {
+            adler_a = (adler_a + value) % 65521;
+            adler_b = (adler_b + adler_a) % 65521;
+        }
+    }
+    writer.PutCode(0, 7);                               // End of block
+    writer.Flush();
+    PutBigEndian(zlib, (adler_b << 16) | adler_a);
+
+    const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    std::vector<unsigned char> png(signature, signature + 8);
+    PutChunk(png, "IHDR", header);
+    PutChunk(png, "IDAT", zlib);
+    PutChunk(png, "IEND", std::vector<unsigned char>());
+    return png;
+}
+
+/**
+ * @brief Block until the workers finished count decodes in total.
+ */
+static bool WaitForDecodes(
+    const int count)
+{
+    for (int ii = 0;
+        ii < 2000 && g_decodes_done < count;
+        ii++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    return g_decodes_done >= count;
+}
+
+/**
+ * @brief Run Update() until the texture under key is ready.
+ */
+static bool WaitUntilReady(
+    TextureManager& textures,
+    const char* key,
+    const std::vector<unsigned char>& data)
+{
+    for (int ii = 0;
+        ii < 2000;
+        ii++)
+    {
+        textures.Update();
+        if (textures.GetMemory(key, data.data(), data.size()).ready == true)
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    return false;
+}
+
+static int Check(
+    const char* name,
+    const bool ok)
+{
+    printf("%-48s %s\n", name, ok == true ? "OK" : "FAILED");
+    return ok == true ? 0 : 1;
+}
+
+/**
+ * @brief The owner is released before either result is taken: its
+ * decode comes back stale, then the alias finds nobody loading its content.
+ */
+static int OwnerReleasedBeforeAccept(
+    const std::vector<unsigned char>& png)
+{
+    TextureManager textures;
+    textures.Init(1);
+    textures.SetWakeCallback(CountDecode);
+    g_decodes_done = 0;
+
+    textures.GetMemory("owner", png.data(), png.size());
+    bool ok = WaitForDecodes(1);
+    textures.GetMemory("alias", png.data(), png.size());
+    ok = ok && WaitForDecodes(2);
+
+    textures.Release("owner");
+    ok = ok && WaitUntilReady(textures, "alias", png);
+    textures.Shutdown();
+
+    return Check("owner released before results are taken", ok);
+}
+
+/**
+ * @brief The alias is already waiting when its owner is released
+ * mid-decode, so it's the owner's stale result that has to requeue it.
+ */
+static int OwnerReleasedWhileAliasWaits(
+    const std::vector<unsigned char>& png)
+{
+    TextureManager textures;
+    textures.Init(2);
+    textures.SetWakeCallback(CountDecode);
+    g_decodes_done = 0;
+
+    // Hashing takes well under the sleep, inflating well over it
+    textures.GetMemory("owner", png.data(), png.size());
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    textures.GetMemory("alias", png.data(), png.size());
+    bool ok = WaitForDecodes(1);
+    textures.Update();
+
+    textures.Release("owner");
+    ok = ok && WaitForDecodes(2);
+    ok = ok && WaitUntilReady(textures, "alias", png);
+    textures.Shutdown();
+
+    return Check("owner released while an alias waits on it", ok);
+}
+
+/**
+ * @brief Duplicates share one texture once the owner is ready.
+ */
+static int AliasSharesOwner(
+    const std::vector<unsigned char>& png)
+{
+    TextureManager textures;
+    textures.Init(2);
+
+    textures.GetMemory("owner", png.data(), png.size());
+    textures.GetMemory("alias", png.data(), png.size());
+    bool ok = WaitUntilReady(textures, "owner", png) &&
+        WaitUntilReady(textures, "alias", png);
+
+    ok = ok && textures.GetMemory("owner", png.data(), png.size()).id ==
+        textures.GetMemory("alias", png.data(), png.size()).id;
+    textures.Shutdown();
+
+    return Check("duplicate content shares one texture", ok);
+}
+
+int main()
+{
+    std::vector<unsigned char> png = MakeRunPng(2048, 0x80);
+    int width = 0;
+    int height = 0;
+    if (stbi_info_from_memory(png.data(), (int)png.size(), &width, &height, NULL) == 0 ||
+        width != 2048)
+    {
+        printf("can't generate the test image\n");
+        return 1;
+    }
+
+    int failures = 0;
+    failures += AliasSharesOwner(png);
+    failures += OwnerReleasedBeforeAccept(png);
+    failures += OwnerReleasedWhileAliasWaits(png);
+
+    return failures > 0 ? 1 : 0;
+}
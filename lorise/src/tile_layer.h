@@ -0,0 +1,419 @@
+#pragma once
+
+// Standard library includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <list>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <unordered_map>
+
+// ImGui includes
+#include "imgui.h"
+
+// Lo-RISE includes
+#include "camera.h"
+#include "utils/mapped_file.h"
+
+/*
+ * Tile pack format. All values are in host byte order.
+ *
+ *  TilePackHeader
+ *  Encoded tile images (PNG, JPEG, anything stb_image reads)
+ *  TilePackEntry table, sorted by TileKey(level, x, y)
+ *
+ * The map is a square of world_size world units with its top-left
+ * corner at world_x, world_y. Level 0 is one tile covering all of it,
+ * each level below splits every tile into four, so level L is a grid of
+ * 2^L by 2^L tiles of tile_size pixels. Tiles may be missing.
+ * lorise_tilepack.out builds a pack from a directory of PNG tiles.
+ */
+
+static const char TILE_PACK_MAGIC[8] = { 'L', 'O', 'R', 'I', 'T', 'I', 'L', 'E' };
+static const uint32_t TILE_PACK_VERSION = 1;
+
+struct TilePackHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t tile_size;             // Pixels along a tile edge
+    uint32_t levels;
+    uint32_t tile_count;
+    float world_x;                  // World position of the map's top-left corner
+    float world_y;
+    float world_size;               // World units along the map edge
+    uint32_t pad;
+    uint64_t index_offset;
+};
+
+struct TilePackEntry
+{
+    uint64_t key;                   // TileKey(level, x, y)
+    uint64_t offset;
+    uint32_t size;
+    uint32_t pad;
+};
+
+static_assert(sizeof(TilePackHeader) == 48, "TilePackHeader is a file format");
+static_assert(sizeof(TilePackEntry) == 24, "TilePackEntry is a file format");
+
+/**
+ * @brief Sortable key of a tile, level first then row then column.
+ */
+inline uint64_t TileKey(
+    const int level,
+    const int x,
+    const int y)
+{
+    return ((uint64_t)level << 58) |
+        ((uint64_t)y << 29) |
+        (uint64_t)x;
+}
+
+/**
+ * @brief Where tile textures come from, so the layer itself stays free
+ * of GL. Implementations decode and upload in the background.
+ */
+struct TileTextureSource
+{
+    virtual ~TileTextureSource() {}
+
+    /**
+     * @brief Texture of an encoded tile image cached under key, or 0 while
+     * it isn't ready. The data stays valid until the key is released.
+     */
+    virtual ImTextureID Acquire(
+        const std::string& key,
+        const unsigned char* data,
+        const size_t size) = 0;
+
+    /**
+     * @brief Drop a key. Once this returns the source no longer reads
+     * its data, so the data may be unmapped.
+     */
+    virtual void Release(
+        const std::string& key) = 0;
+};
+
+/**
+ * @brief Map imagery drawn under the grid. Each frame the quadtree level
+ * matching the zoom is picked and its tiles covering the view are drawn.
+ * Tiles still loading show the nearest resident ancestor instead. At most
+ * capacity tiles (plus those on screen) are kept, least recently used first out.
+ */
+class TileLayer
+{
+public:
+    static const int DEFAULT_CAPACITY = 128;
+
+    TileLayer() = default;
+    TileLayer(const TileLayer&) = delete;
+    TileLayer& operator=(const TileLayer&) = delete;
+
+    ~TileLayer()
+    {
+        Close();
+    }
+
+    bool Open(
+        const std::string& path,
+        TileTextureSource& texture_source,
+        const int max_resident = DEFAULT_CAPACITY)
+    {
+        Close();
+
+        if (file.Open(path.c_str()) == false ||
+            file.Size() < sizeof(TilePackHeader))
+        {
+            fprintf(stderr, "Lo-RISE: can't open tile pack %s\n", path.c_str());
+            return false;
+        }
+
+        memcpy(&header, file.Data(), sizeof(header));
+        uint64_t index_end = header.index_offset + (uint64_t)header.tile_count * sizeof(TilePackEntry);
+        if (memcmp(header.magic, TILE_PACK_MAGIC, sizeof(header.magic)) != 0 ||
+            header.version != TILE_PACK_VERSION ||
+            header.levels == 0 ||
+            header.levels > 24 ||
+            header.tile_size == 0 ||
+            header.world_size <= 0 ||
+            index_end > file.Size())
+        {
+            fprintf(stderr, "Lo-RISE: %s is not a valid tile pack\n", path.c_str());
+            file.Close();
+            return false;
+        }
+
+        source = &texture_source;
+        capacity = std::max(max_resident, 1);
+        name_prefix = path + ":";
+        return true;
+    }
+
+    /**
+     * @brief Release every resident tile, then unmap the pack.
+     */
+    void Close()
+    {
+        if (source != NULL)
+        {
+            for (const Resident& tile : lru)
+            {
+                source->Release(tile.name);
+            }
+        }
+
+        lru.clear();
+        resident.clear();
+        source = NULL;
+        file.Close();
+    }
+
+    bool IsOpen() const
+    {
+        return source != NULL;
+    }
+
+    /**
+     * @brief Quadtree level whose texels best match screen pixels at this zoom.
+     */
+    int LevelForZoom(
+        const float camera_zoom) const
+    {
+        float tiles_across = camera_zoom * header.world_size / (float)header.tile_size;
+        int level = (int)std::ceil(std::log2(std::max(tiles_across, 1.0f)));
+        return std::min(
+            level,
+            (int)header.levels - 1);
+    }
+
+    /**
+     * @brief Draw the tiles covering the view. Screen positions are
+     * relative to origin, as everywhere else in the Lo-RISE window.
+     */
+    void Draw(
+        ImDrawList* draw_list,
+        const ImVec2 origin,
+        const ImVec2 view_size,
+        const ImVec2 camera_pan,
+        const float camera_zoom)
+    {
+        if (IsOpen() == false)
+        {
+            return;
+        }
+
+        frame++;
+
+        ImVec2 center = ImVec2(
+            view_size.x / 2,
+            view_size.y / 2);
+
+        CameraTransform camera = CameraTransform(
+            origin,
+            center,
+            camera_pan,
+            camera_zoom);
+
+        ImVec2 world_min = camera.ScreenToWorld(origin);
+        ImVec2 world_max = camera.ScreenToWorld(ImVec2(
+            origin.x + view_size.x,
+            origin.y + view_size.y));
+
+        int level = LevelForZoom(camera_zoom);
+        int tiles_per_side = 1 << level;
+        float tile_world = header.world_size / (float)tiles_per_side;
+
+        int x0 = std::max((int)std::floor((world_min.x - header.world_x) / tile_world), 0);
+        int y0 = std::max((int)std::floor((world_min.y - header.world_y) / tile_world), 0);
+        int x1 = std::min((int)std::floor((world_max.x - header.world_x) / tile_world), tiles_per_side - 1);
+        int y1 = std::min((int)std::floor((world_max.y - header.world_y) / tile_world), tiles_per_side - 1);
+
+        for (int ty = y0;
+            ty <= y1;
+            ty++)
+        {
+            for (int tx = x0;
+                tx <= x1;
+                tx++)
+            {
+                ImTextureID texture = Touch(
+                    level,
+                    tx,
+                    ty);
+
+                // Show a resident ancestor's quarter while the tile loads
+                int ancestor = level;
+                int ax = tx;
+                int ay = ty;
+                while (texture == 0 &&
+                    ancestor > 0)
+                {
+                    ancestor--;
+                    ax >>= 1;
+                    ay >>= 1;
+                    texture = Peek(
+                        ancestor,
+                        ax,
+                        ay);
+                }
+
+                if (texture == 0)
+                {
+                    continue;
+                }
+
+                int depth = level - ancestor;
+                float uv_size = 1.0f / (float)(1 << depth);
+                ImVec2 uv_min = ImVec2(
+                    (float)(tx - (ax << depth)) * uv_size,
+                    (float)(ty - (ay << depth)) * uv_size);
+
+                ImVec2 tile_min = ImVec2(
+                    header.world_x + tx * tile_world,
+                    header.world_y + ty * tile_world);
+
+                ImVec2 p_min = camera.WorldToScreen(tile_min);
+
+                draw_list->AddImage(
+                    texture,
+                    p_min,
+                    ImVec2(
+                        p_min.x + tile_world * camera_zoom,
+                        p_min.y + tile_world * camera_zoom),
+                    uv_min,
+                    ImVec2(
+                        uv_min.x + uv_size,
+                        uv_min.y + uv_size));
+            }
+        }
+
+        Evict();
+    }
+
+private:
+    /**
+     * @brief A tile with a texture requested from the source.
+     */
+    struct Resident
+    {
+        uint64_t key;
+        std::string name;           // Key in the texture source
+        const TilePackEntry* entry;
+        uint64_t last_used;         // Frame the tile was last drawn
+    };
+
+    MappedFile file;
+    TilePackHeader header;
+    TileTextureSource* source = NULL;
+    int capacity = DEFAULT_CAPACITY;
+    std::string name_prefix;
+    uint64_t frame = 0;
+
+    std::list<Resident> lru;                                            // Most recently used first
+    std::unordered_map<uint64_t, std::list<Resident>::iterator> resident;
+
+    const TilePackEntry* FindEntry(
+        const uint64_t key) const
+    {
+        const TilePackEntry* entries = (const TilePackEntry*)(file.Data() + header.index_offset);
+        const TilePackEntry* end = entries + header.tile_count;
+        const TilePackEntry* it = std::lower_bound(
+            entries,
+            end,
+            key,
+            [](const TilePackEntry& entry, const uint64_t value) { return entry.key < value; });
+
+        if (it == end ||
+            it->key != key ||
+            it->offset + it->size > file.Size())
+        {
+            return NULL;
+        }
+
+        return it;
+    }
+
+    /**
+     * @brief Texture of a tile this frame, requesting it if needed.
+     * Returns 0 if the tile is missing or not loaded yet.
+     */
+    ImTextureID Touch(
+        const int level,
+        const int x,
+        const int y)
+    {
+        uint64_t key = TileKey(level, x, y);
+        auto it = resident.find(key);
+        if (it == resident.end())
+        {
+            const TilePackEntry* entry = FindEntry(key);
+            if (entry == NULL)
+            {
+                return 0;
+            }
+
+            char name[48];
+            snprintf(name, sizeof(name), "%d/%d/%d", level, x, y);
+
+            Resident tile;
+            tile.key = key;
+            tile.name = name_prefix + name;
+            tile.entry = entry;
+            lru.push_front(tile);
+            it = resident.emplace(key, lru.begin()).first;
+        }
+        else
+        {
+            lru.splice(lru.begin(), lru, it->second);
+        }
+
+        Resident& tile = *it->second;
+        tile.last_used = frame;
+        return source->Acquire(
+            tile.name,
+            file.Data() + tile.entry->offset,
+            tile.entry->size);
+    }
+
+    /**
+     * @brief Texture of a tile if it's already resident and loaded.
+     * Keeps it resident while it stands in for its descendants.
+     */
+    ImTextureID Peek(
+        const int level,
+        const int x,
+        const int y)
+    {
+        auto it = resident.find(TileKey(level, x, y));
+        if (it == resident.end())
+        {
+            return 0;
+        }
+
+        lru.splice(lru.begin(), lru, it->second);
+        Resident& tile = *it->second;
+        tile.last_used = frame;
+        return source->Acquire(
+            tile.name,
+            file.Data() + tile.entry->offset,
+            tile.entry->size);
+    }
+
+    /**
+     * @brief Release least recently used tiles over capacity,
+     * never ones drawn this frame.
+     */
+    void Evict()
+    {
+        while ((int)lru.size() > capacity &&
+            lru.back().last_used != frame)
+        {
+            source->Release(lru.back().name);
+            resident.erase(lru.back().key);
+            lru.pop_back();
+        }
+    }
+};
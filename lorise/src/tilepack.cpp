@@ -0,0 +1,134 @@
+// Lo-RISE tile pack builder
+// (pack a quadtree of map tiles into one file the Lo-RISE imagery layer memory-maps, see tile_layer.h)
+// Tiles are read from <tile dir>/<level>/<x>/<y>.png (or .jpg), the usual web map layout.
+// Their encoded bytes are copied as-is, missing tiles are skipped.
+//
+// Usage: lorise_tilepack.out <out pack> <tile dir> <levels> <tile size> <world x> <world y> <world size>
+
+// Standard library includes
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+// Lo-RISE includes
+#include "tile_layer.h"
+
+/**
+ * @brief Read a whole file, returns false if it doesn't exist.
+ */
+static bool ReadFile(
+    const char* path,
+    std::vector<unsigned char>& data)
+{
+    FILE* f = fopen(path, "rb");
+    if (f == NULL)
+    {
+        return false;
+    }
+
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    data.resize(size > 0 ? (size_t)size : 0);
+    size_t read = fread(data.data(), 1, data.size(), f);
+    fclose(f);
+    return size > 0 && read == data.size();
+}
+
+int main(int argc, char** argv)
+{
+    if (argc != 8)
+    {
+        fprintf(stderr, "Usage: %s <out pack> <tile dir> <levels> <tile size> <world x> <world y> <world size>\n", argv[0]);
+        return 1;
+    }
+
+    const char* out_path = argv[1];
+    const char* tile_dir = argv[2];
+
+    TilePackHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, TILE_PACK_MAGIC, sizeof(header.magic));
+    header.version = TILE_PACK_VERSION;
+    header.levels = (uint32_t)std::min(std::max(atoi(argv[3]), 1), 24);
+    header.tile_size = (uint32_t)std::max(atoi(argv[4]), 1);
+    header.world_x = (float)atof(argv[5]);
+    header.world_y = (float)atof(argv[6]);
+    header.world_size = (float)atof(argv[7]);
+
+    FILE* out = fopen(out_path, "wb");
+    if (out == NULL)
+    {
+        fprintf(stderr, "Can't open %s for writing\n", out_path);
+        return 1;
+    }
+
+    fwrite(&header, sizeof(header), 1, out);
+    uint64_t offset = sizeof(header);
+
+    // Walking levels, then rows, then columns writes entries already sorted by TileKey()
+    std::vector<TilePackEntry> entries;
+    std::vector<unsigned char> data;
+    const char* extensions[] = { "png", "jpg" };
+    for (int level = 0;
+        level < (int)header.levels;
+        level++)
+    {
+        int tiles_per_side = 1 << level;
+        int found = 0;
+        for (int y = 0;
+            y < tiles_per_side;
+            y++)
+        {
+            for (int x = 0;
+                x < tiles_per_side;
+                x++)
+            {
+                char path[1024];
+                bool loaded = false;
+                for (const char* extension : extensions)
+                {
+                    snprintf(path, sizeof(path), "%s/%d/%d/%d.%s", tile_dir, level, x, y, extension);
+                    loaded = loaded || ReadFile(path, data);
+                }
+
+                if (loaded == false)
+                {
+                    continue;
+                }
+
+                TilePackEntry entry;
+                memset(&entry, 0, sizeof(entry));
+                entry.key = TileKey(level, x, y);
+                entry.offset = offset;
+                entry.size = (uint32_t)data.size();
+                entries.push_back(entry);
+
+                fwrite(data.data(), 1, data.size(), out);
+                offset += data.size();
+                found++;
+            }
+        }
+
+        printf("level %2d: %d of %d tiles\n", level, found, tiles_per_side * tiles_per_side);
+    }
+
+    header.tile_count = (uint32_t)entries.size();
+    header.index_offset = offset;
+    fwrite(entries.data(), sizeof(TilePackEntry), entries.size(), out);
+
+    fseek(out, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, out);
+    fclose(out);
+
+    printf("%s: %u tiles, %llu bytes\n",
+        out_path,
+        header.tile_count,
+        (unsigned long long)(offset + entries.size() * sizeof(TilePackEntry)));
+
+    return 0;
+}
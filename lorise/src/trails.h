@@ -0,0 +1,209 @@
+#pragma once
+
+// Standard library includes
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// ImGui includes
+#include "imgui.h"
+
+// Lo-RISE includes
+#include "camera.h"
+#include "entity_store.h"
+#include "world_update.h"
+
+/**
+ * @brief Recent path of every agent, sampled at a fixed interval.
+ *
+ * Samples live in one slab of capacity * samples_per_agent world
+ * positions, agent ii owning the ring at ii * samples_per_agent. Each ring
+ * overwrites its oldest sample once full, so memory only grows when agents
+ * are added past the reserved capacity: 8 bytes per sample plus 12 per agent.
+ */
+class TrailBuffer
+{
+public:
+    static const int DEFAULT_SAMPLES = 32;
+    static constexpr double DEFAULT_INTERVAL = 0.5;    // Seconds between samples
+    static constexpr float MIN_STEP = 1.0f;             // World distance an agent must move to get a new sample
+    static constexpr float MIN_PIXELS = 2.0f;           // Closer samples on screen are dropped when drawing
+
+    /**
+     * @brief Set the trail length and preallocate for agent_capacity agents.
+     * Clears any existing trails.
+     */
+    void Reset(
+        const int agent_capacity,
+        const int samples_per_agent = DEFAULT_SAMPLES,
+        const double sample_interval = DEFAULT_INTERVAL)
+    {
+        samples = std::max(std::min(samples_per_agent, 0xFFFF), 2);
+        interval = sample_interval;
+        last_sample_time = -1;
+        capacity = 0;
+        std::vector<ImVec2>().swap(points);
+        std::vector<uint16_t>().swap(head);
+        std::vector<uint16_t>().swap(count);
+        std::vector<ImVec2>().swap(last);
+        Reserve(agent_capacity);
+    }
+
+    /**
+     * @brief Forget an agent's trail, e.g. when its slot is reused.
+     */
+    void Clear(
+        const int agent)
+    {
+        if (agent < capacity)
+        {
+            count[agent] = 0;
+        }
+    }
+
+    /**
+     * @brief Bytes held by the slab and ring bookkeeping.
+     */
+    size_t MemoryBytes() const
+    {
+        return points.capacity() * sizeof(ImVec2) +
+            head.capacity() * sizeof(uint16_t) +
+            count.capacity() * sizeof(uint16_t) +
+            last.capacity() * sizeof(ImVec2);
+    }
+
+    /**
+     * @brief Add a sample for every agent that moved, if the sample interval
+     * has passed since the last one. Call once per frame with the positions
+     * agents are drawn at, so trails never run ahead of their icons.
+     */
+    void Sample(
+        const WorldPositions& agents,
+        const double time)
+    {
+        if (last_sample_time >= 0 &&
+            time - last_sample_time < interval)
+        {
+            return;
+        }
+
+        last_sample_time = time;
+        Reserve(agents.count);
+
+        const float min_step_2 = MIN_STEP * MIN_STEP;
+        for (int ii = 0;
+            ii < agents.count;
+            ii++)
+        {
+            ImVec2 pos = ImVec2(
+                agents.x[ii],
+                agents.y[ii]);
+
+            // Compare against the packed copy of the newest sample,
+            // so agents that didn't move never touch their ring
+            if (count[ii] > 0)
+            {
+                float dx = pos.x - last[ii].x;
+                float dy = pos.y - last[ii].y;
+                if (dx * dx + dy * dy < min_step_2)
+                {
+                    continue;
+                }
+            }
+
+            head[ii] = (uint16_t)((head[ii] + 1) % samples);
+            points[(size_t)ii * samples + head[ii]] = pos;
+            last[ii] = pos;
+            count[ii] = (uint16_t)std::min(count[ii] + 1, samples);
+        }
+    }
+
+    /**
+     * @brief Draw the trails of the given agents as polylines, from their
+     * current screen position back to their oldest sample. Samples closer
+     * than MIN_PIXELS to the last point kept are skipped, so zooming out
+     * draws fewer segments.
+     */
+    void Draw(
+        ImDrawList* draw_list,
+        const CameraTransform& camera,
+        const ScreenPositions& screen,
+        const EntityStore& agents,
+        const std::vector<int>& visible)
+    {
+        const float min_pixels_2 = MIN_PIXELS * MIN_PIXELS;
+        for (int index : visible)
+        {
+            if (index >= capacity ||
+                count[index] == 0)
+            {
+                continue;
+            }
+
+            const ImVec2* ring = &points[(size_t)index * samples];
+            scratch.resize(0);
+            scratch.push_back(screen.Get(index));
+
+            for (int ss = 0;
+                ss < count[index];
+                ss++)
+            {
+                ImVec2 pos = camera.WorldToScreen(ring[(head[index] + samples - ss) % samples]);
+                const ImVec2 last = scratch.back();
+                float dx = pos.x - last.x;
+                float dy = pos.y - last.y;
+                if (dx * dx + dy * dy >= min_pixels_2)
+                {
+                    scratch.push_back(pos);
+                }
+            }
+
+            if (scratch.Size < 2)
+            {
+                continue;
+            }
+
+            draw_list->AddPolyline(
+                scratch.Data,
+                scratch.Size,
+                (agents.color[index] & ~IM_COL32_A_MASK) | IM_COL32(0, 0, 0, 96),
+                ImDrawFlags_None,
+                1.0f);
+        }
+    }
+
+private:
+    int samples = DEFAULT_SAMPLES;          // Ring size per agent
+    double interval = DEFAULT_INTERVAL;
+    double last_sample_time = -1;
+    int capacity = 0;                       // Agents with a ring in the slab
+
+    std::vector<ImVec2> points;             // capacity * samples world positions
+    std::vector<uint16_t> head;             // Per agent, slot of the newest sample
+    std::vector<uint16_t> count;            // Per agent, samples in the ring
+    std::vector<ImVec2> last;               // Per agent, newest sample
+    ImVector<ImVec2> scratch;               // Screen points of the trail being drawn
+
+    /**
+     * @brief Make room for agent_count agents. Existing trails are kept.
+     */
+    void Reserve(
+        const int agent_count)
+    {
+        if (agent_count <= capacity)
+        {
+            return;
+        }
+
+        // Exact reservations, resize() alone may overallocate
+        points.reserve((size_t)agent_count * samples);
+        head.reserve(agent_count);
+        count.reserve(agent_count);
+        last.reserve(agent_count);
+        points.resize((size_t)agent_count * samples);
+        head.resize(agent_count, 0);
+        count.resize(agent_count, 0);
+        last.resize(agent_count);
+        capacity = agent_count;
+    }
+};
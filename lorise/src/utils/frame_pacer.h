@@ -0,0 +1,148 @@
+#pragma once
+
+// Standard library includes
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+// Backend includes
+#include <GLFW/glfw3.h>
+
+/**
+ * @brief Decides when the main loop needs to draw a frame.
+ * When enabled, the loop sleeps in glfwWaitEventsTimeout() until
+ * there is input, a Wake() from another thread, a requested animation
+ * deadline, or max_idle seconds have passed since the last frame.
+ * A few frames are drawn after every event so ImGui can settle
+ * (hover states, windows resizing to fit, etc.).
+ */
+class FramePacer
+{
+public:
+    static const int SETTLE_FRAMES = 3;
+
+    /**
+     * @brief A max_idle of zero or less draws every iteration, as before.
+     */
+    explicit FramePacer(
+        const double max_idle_seconds) :
+        max_idle(max_idle_seconds)
+    {
+    }
+
+    /**
+     * @brief Count window events as activity. Call before
+     * ImGui_ImplGlfw_InitForOpenGL() so the backend chains these callbacks.
+     */
+    void InstallCallbacks(
+        GLFWwindow* window)
+    {
+        glfwSetWindowFocusCallback(window, [](GLFWwindow*, int) { NoteEvent(); });
+        glfwSetCursorEnterCallback(window, [](GLFWwindow*, int) { NoteEvent(); });
+        glfwSetCursorPosCallback(window, [](GLFWwindow*, double, double) { NoteEvent(); });
+        glfwSetMouseButtonCallback(window, [](GLFWwindow*, int, int, int) { NoteEvent(); });
+        glfwSetScrollCallback(window, [](GLFWwindow*, double, double) { NoteEvent(); });
+        glfwSetKeyCallback(window, [](GLFWwindow*, int, int, int, int) { NoteEvent(); });
+        glfwSetCharCallback(window, [](GLFWwindow*, unsigned int) { NoteEvent(); });
+        glfwSetFramebufferSizeCallback(window, [](GLFWwindow*, int, int) { NoteEvent(); });
+        glfwSetWindowRefreshCallback(window, [](GLFWwindow*) { NoteEvent(); });
+    }
+
+    /**
+     * @brief Thread-safe. Wake the main loop and make it draw a frame,
+     * e.g. when new entity updates were queued.
+     */
+    static void Wake()
+    {
+        NoteEvent();
+        glfwPostEmptyEvent();
+    }
+
+    /**
+     * @brief Draw the next frame too, for anything animating.
+     */
+    void RequestFrame()
+    {
+        deadline = 0;
+    }
+
+    /**
+     * @brief Draw a frame no later than the given glfwGetTime() time.
+     */
+    void RequestFrameAt(
+        const double time)
+    {
+        deadline = std::min(
+            deadline,
+            time);
+    }
+
+    /**
+     * @brief Process events, sleeping while there is nothing to draw.
+     * Returns true if a frame should be drawn now.
+     */
+    bool WaitForFrame()
+    {
+        if (max_idle <= 0)
+        {
+            glfwPollEvents();
+            return true;
+        }
+
+        double now = glfwGetTime();
+        if (settle_frames > 0 ||
+            deadline <= now)
+        {
+            glfwPollEvents();
+        }
+        else
+        {
+            double wake_time = std::min(
+                last_frame + max_idle,
+                deadline);
+
+            glfwWaitEventsTimeout(std::max(wake_time - now, 0.0));
+        }
+
+        now = glfwGetTime();
+        int events = EventCount().load(std::memory_order_acquire);
+        if (events != seen_events)
+        {
+            seen_events = events;
+            settle_frames = SETTLE_FRAMES;
+        }
+
+        if (settle_frames == 0 &&
+            deadline > now &&
+            now - last_frame < max_idle)
+        {
+            return false;
+        }
+
+        if (deadline <= now)
+        {
+            deadline = std::numeric_limits<double>::infinity();
+        }
+        settle_frames = std::max(settle_frames - 1, 0);
+        last_frame = now;
+        return true;
+    }
+
+private:
+    double max_idle;
+    double last_frame = 0;
+    double deadline = 0;
+    int settle_frames = SETTLE_FRAMES;
+    int seen_events = 0;
+
+    static std::atomic<int>& EventCount()
+    {
+        static std::atomic<int> count{0};
+        return count;
+    }
+
+    static void NoteEvent()
+    {
+        EventCount().fetch_add(1, std::memory_order_release);
+    }
+};
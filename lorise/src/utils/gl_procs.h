@@ -0,0 +1,181 @@
+#pragma once
+
+// Standard library includes
+#include <cstddef>
+
+// Backend includes
+#define GL_SILENCE_DEPRECATION
+#if defined(IMGUI_IMPL_OPENGL_ES2)
+#include <GLES2/gl2.h>
+#endif
+#include <GLFW/glfw3.h> // Will drag system OpenGL headers
+
+// System OpenGL headers may only expose GL 1.1 (e.g. Windows), so
+// declare the few newer entry points and enums Lo-RISE uses itself.
+// The ImGui OpenGL3 backend keeps its own private loader.
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER                0x8B30
+#define GL_VERTEX_SHADER                  0x8B31
+#define GL_COMPILE_STATUS                 0x8B81
+#define GL_LINK_STATUS                    0x8B82
+#define GL_INFO_LOG_LENGTH                0x8B84
+#endif
+
+#ifndef GL_PIXEL_UNPACK_BUFFER
+#define GL_PIXEL_UNPACK_BUFFER            0x88EC
+#endif
+
+#ifndef GL_STREAM_DRAW
+#define GL_STREAM_DRAW                    0x88E0
+#endif
+
+#ifndef GL_MAP_WRITE_BIT
+#define GL_MAP_WRITE_BIT                  0x0002
+#define GL_MAP_INVALIDATE_BUFFER_BIT      0x0008
+#endif
+
+typedef GLuint (APIENTRY* GLCreateShaderProc)(GLenum type);
+typedef void (APIENTRY* GLShaderSourceProc)(GLuint shader, GLsizei count, const char* const* string, const GLint* length);
+typedef void (APIENTRY* GLCompileShaderProc)(GLuint shader);
+typedef void (APIENTRY* GLGetShaderivProc)(GLuint shader, GLenum pname, GLint* params);
+typedef void (APIENTRY* GLGetShaderInfoLogProc)(GLuint shader, GLsizei buf_size, GLsizei* length, char* info_log);
+typedef void (APIENTRY* GLDeleteShaderProc)(GLuint shader);
+typedef GLuint (APIENTRY* GLCreateProgramProc)(void);
+typedef void (APIENTRY* GLAttachShaderProc)(GLuint program, GLuint shader);
+typedef void (APIENTRY* GLDetachShaderProc)(GLuint program, GLuint shader);
+typedef void (APIENTRY* GLLinkProgramProc)(GLuint program);
+typedef void (APIENTRY* GLGetProgramivProc)(GLuint program, GLenum pname, GLint* params);
+typedef void (APIENTRY* GLGetProgramInfoLogProc)(GLuint program, GLsizei buf_size, GLsizei* length, char* info_log);
+typedef void (APIENTRY* GLDeleteProgramProc)(GLuint program);
+typedef void (APIENTRY* GLUseProgramProc)(GLuint program);
+typedef GLint (APIENTRY* GLGetUniformLocationProc)(GLuint program, const char* name);
+typedef void (APIENTRY* GLUniform1fProc)(GLint location, GLfloat v0);
+typedef void (APIENTRY* GLUniform2fProc)(GLint location, GLfloat v0, GLfloat v1);
+typedef void (APIENTRY* GLUniform4fProc)(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3);
+typedef void (APIENTRY* GLGenBuffersProc)(GLsizei n, GLuint* buffers);
+typedef void (APIENTRY* GLDeleteBuffersProc)(GLsizei n, const GLuint* buffers);
+typedef void (APIENTRY* GLBindBufferProc)(GLenum target, GLuint buffer);
+typedef void (APIENTRY* GLBufferDataProc)(GLenum target, ptrdiff_t size, const void* data, GLenum usage);
+typedef void* (APIENTRY* GLMapBufferRangeProc)(GLenum target, ptrdiff_t offset, ptrdiff_t length, GLbitfield access);
+typedef GLboolean (APIENTRY* GLUnmapBufferProc)(GLenum target);
+
+/**
+ * @brief OpenGL entry points beyond GL 1.1, resolved at runtime through GLFW.
+ */
+struct GLProcs
+{
+    bool loaded = false;
+
+    GLCreateShaderProc CreateShader = NULL;
+    GLShaderSourceProc ShaderSource = NULL;
+    GLCompileShaderProc CompileShader = NULL;
+    GLGetShaderivProc GetShaderiv = NULL;
+    GLGetShaderInfoLogProc GetShaderInfoLog = NULL;
+    GLDeleteShaderProc DeleteShader = NULL;
+    GLCreateProgramProc CreateProgram = NULL;
+    GLAttachShaderProc AttachShader = NULL;
+    GLDetachShaderProc DetachShader = NULL;
+    GLLinkProgramProc LinkProgram = NULL;
+    GLGetProgramivProc GetProgramiv = NULL;
+    GLGetProgramInfoLogProc GetProgramInfoLog = NULL;
+    GLDeleteProgramProc DeleteProgram = NULL;
+    GLUseProgramProc UseProgram = NULL;
+    GLGetUniformLocationProc GetUniformLocation = NULL;
+    GLUniform1fProc Uniform1f = NULL;
+    GLUniform2fProc Uniform2f = NULL;
+    GLUniform4fProc Uniform4f = NULL;
+
+    // Pixel buffer objects, optional (GL 3.0 / GLES 3.0)
+    bool buffers_loaded = false;
+
+    GLGenBuffersProc GenBuffers = NULL;
+    GLDeleteBuffersProc DeleteBuffers = NULL;
+    GLBindBufferProc BindBuffer = NULL;
+    GLBufferDataProc BufferData = NULL;
+    GLMapBufferRangeProc MapBufferRange = NULL;
+    GLUnmapBufferProc UnmapBuffer = NULL;
+};
+
+/**
+ * @brief Access the process wide GL entry points.
+ */
+GLProcs& GetGLProcs()
+{
+    static GLProcs procs;
+    return procs;
+}
+
+/**
+ * @brief Resolve the GL entry points. Needs a current GL context.
+ * Returns false if any of them is unavailable.
+ */
+bool LoadGLProcs()
+{
+    GLProcs& gl = GetGLProcs();
+    if (gl.loaded == true)
+    {
+        return true;
+    }
+
+    bool ok = true;
+    auto load = [&ok](const char* name)
+    {
+        GLFWglproc proc = glfwGetProcAddress(name);
+        ok = ok && proc != NULL;
+        return proc;
+    };
+
+    gl.CreateShader = (GLCreateShaderProc)load("glCreateShader");
+    gl.ShaderSource = (GLShaderSourceProc)load("glShaderSource");
+    gl.CompileShader = (GLCompileShaderProc)load("glCompileShader");
+    gl.GetShaderiv = (GLGetShaderivProc)load("glGetShaderiv");
+    gl.GetShaderInfoLog = (GLGetShaderInfoLogProc)load("glGetShaderInfoLog");
+    gl.DeleteShader = (GLDeleteShaderProc)load("glDeleteShader");
+    gl.CreateProgram = (GLCreateProgramProc)load("glCreateProgram");
+    gl.AttachShader = (GLAttachShaderProc)load("glAttachShader");
+    gl.DetachShader = (GLDetachShaderProc)load("glDetachShader");
+    gl.LinkProgram = (GLLinkProgramProc)load("glLinkProgram");
+    gl.GetProgramiv = (GLGetProgramivProc)load("glGetProgramiv");
+    gl.GetProgramInfoLog = (GLGetProgramInfoLogProc)load("glGetProgramInfoLog");
+    gl.DeleteProgram = (GLDeleteProgramProc)load("glDeleteProgram");
+    gl.UseProgram = (GLUseProgramProc)load("glUseProgram");
+    gl.GetUniformLocation = (GLGetUniformLocationProc)load("glGetUniformLocation");
+    gl.Uniform1f = (GLUniform1fProc)load("glUniform1f");
+    gl.Uniform2f = (GLUniform2fProc)load("glUniform2f");
+    gl.Uniform4f = (GLUniform4fProc)load("glUniform4f");
+
+    gl.loaded = ok;
+    return ok;
+}
+
+/**
+ * @brief Resolve the buffer object entry points used for streaming
+ * uploads. Needs a current GL context. Returns false if unavailable,
+ * callers then upload straight from client memory.
+ */
+bool LoadGLBufferProcs()
+{
+    GLProcs& gl = GetGLProcs();
+    if (gl.buffers_loaded == true)
+    {
+        return true;
+    }
+
+    bool ok = true;
+    auto load = [&ok](const char* name)
+    {
+        GLFWglproc proc = glfwGetProcAddress(name);
+        ok = ok && proc != NULL;
+        return proc;
+    };
+
+    gl.GenBuffers = (GLGenBuffersProc)load("glGenBuffers");
+    gl.DeleteBuffers = (GLDeleteBuffersProc)load("glDeleteBuffers");
+    gl.BindBuffer = (GLBindBufferProc)load("glBindBuffer");
+    gl.BufferData = (GLBufferDataProc)load("glBufferData");
+    gl.MapBufferRange = (GLMapBufferRangeProc)load("glMapBufferRange");
+    gl.UnmapBuffer = (GLUnmapBufferProc)load("glUnmapBuffer");
+
+    gl.buffers_loaded = ok;
+    return ok;
+}
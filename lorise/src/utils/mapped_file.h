@@ -0,0 +1,166 @@
+#pragma once
+
+// Standard library includes
+#include <cstddef>
+#include <cstdint>
+#include <stdio.h>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Read-only view of a whole file. Memory-mapped where the
+ * platform allows it, otherwise read into memory once.
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+        Close();
+    }
+
+    bool Open(
+        const char* path)
+    {
+        Close();
+
+#if defined(_WIN32)
+        file_handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file_handle != INVALID_HANDLE_VALUE)
+        {
+            LARGE_INTEGER file_size;
+            GetFileSizeEx(file_handle, &file_size);
+            size = (size_t)file_size.QuadPart;
+            mapping_handle = size > 0 ?
+                CreateFileMappingA(file_handle, NULL, PAGE_READONLY, 0, 0, NULL) :
+                NULL;
+            if (mapping_handle != NULL)
+            {
+                data = (const uint8_t*)MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0);
+            }
+            if (data != NULL)
+            {
+                return true;
+            }
+            Close();
+        }
+#else
+        int fd = open(path, O_RDONLY);
+        if (fd >= 0)
+        {
+            struct stat st;
+            if (fstat(fd, &st) == 0 &&
+                st.st_size > 0)
+            {
+                void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (ptr != MAP_FAILED)
+                {
+                    data = (const uint8_t*)ptr;
+                    size = (size_t)st.st_size;
+                    mapped = true;
+                }
+            }
+            close(fd);
+            if (data != NULL)
+            {
+                return true;
+            }
+        }
+#endif
+
+        // Fall back to reading the file
+        FILE* f = fopen(path, "rb");
+        if (f == NULL)
+        {
+            return false;
+        }
+
+        fseek(f, 0, SEEK_END);
+        long file_size = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        if (file_size <= 0)
+        {
+            fclose(f);
+            return false;
+        }
+
+        buffer.resize((size_t)file_size);
+        size_t read = fread(buffer.data(), 1, buffer.size(), f);
+        fclose(f);
+        if (read != buffer.size())
+        {
+            buffer.clear();
+            return false;
+        }
+
+        data = buffer.data();
+        size = buffer.size();
+        return true;
+    }
+
+    void Close()
+    {
+#if defined(_WIN32)
+        if (data != NULL && buffer.empty() == true)
+        {
+            UnmapViewOfFile(data);
+        }
+        if (mapping_handle != NULL)
+        {
+            CloseHandle(mapping_handle);
+        }
+        if (file_handle != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(file_handle);
+        }
+        mapping_handle = NULL;
+        file_handle = INVALID_HANDLE_VALUE;
+#else
+        if (mapped == true)
+        {
+            munmap((void*)data, size);
+        }
+        mapped = false;
+#endif
+        buffer.clear();
+        data = NULL;
+        size = 0;
+    }
+
+    const uint8_t* Data() const
+    {
+        return data;
+    }
+
+    size_t Size() const
+    {
+        return size;
+    }
+
+private:
+    const uint8_t* data = NULL;
+    size_t size = 0;
+    std::vector<uint8_t> buffer;    // Only used when mapping isn't possible
+
+#if defined(_WIN32)
+    HANDLE file_handle = INVALID_HANDLE_VALUE;
+    HANDLE mapping_handle = NULL;
+#else
+    bool mapped = false;
+#endif
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+// Standard library includes
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Bounded lock-free ring buffer for exactly one producer
+ * thread and one consumer thread. Capacity is rounded up to a
+ * power of two. Neither side ever blocks; a full ring rejects
+ * pushes and an empty ring returns nothing.
+ */
+template <typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(
+        size_t capacity)
+    {
+        size_t size = 1;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    /**
+     * @brief Producer side. Returns false if the ring is full.
+     */
+    bool Push(
+        const T& item)
+    {
+        size_t tail = write_index.load(std::memory_order_relaxed);
+        if (tail - cached_read_index > mask)
+        {
+            cached_read_index = read_index.load(std::memory_order_acquire);
+            if (tail - cached_read_index > mask)
+            {
+                return false;
+            }
+        }
+
+        slots[tail & mask] = item;
+        write_index.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side. Returns false if the ring is empty.
+     */
+    bool Pop(
+        T& item)
+    {
+        size_t head = read_index.load(std::memory_order_relaxed);
+        if (head == cached_write_index)
+        {
+            cached_write_index = write_index.load(std::memory_order_acquire);
+            if (head == cached_write_index)
+            {
+                return false;
+            }
+        }
+
+        item = slots[head & mask];
+        read_index.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side. Pop up to max_count items into out,
+     * publishing the new read position once. Returns the count popped.
+     */
+    size_t PopBatch(
+        T* out,
+        size_t max_count)
+    {
+        size_t head = read_index.load(std::memory_order_relaxed);
+        cached_write_index = write_index.load(std::memory_order_acquire);
+
+        size_t count = cached_write_index - head;
+        if (count > max_count)
+        {
+            count = max_count;
+        }
+
+        for (size_t ii = 0;
+            ii < count;
+            ii++)
+        {
+            out[ii] = slots[(head + ii) & mask];
+        }
+
+        read_index.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    size_t Capacity() const
+    {
+        return mask + 1;
+    }
+
+private:
+    std::vector<T> slots;
+    size_t mask = 0;
+
+    // Each side owns one index and caches the other's, kept
+    // on separate cache lines to avoid false sharing
+    alignas(64) std::atomic<size_t> write_index{0};
+    size_t cached_read_index = 0;
+    alignas(64) std::atomic<size_t> read_index{0};
+    size_t cached_write_index = 0;
+};
@@ -0,0 +1,808 @@
+#pragma once
+
+// Standard library includes
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// ImGui includes
+#include "imgui.h"
+
+// Lo-RISE includes
+#include "gl_procs.h"
+#include "textures.h"
+
+/**
+ * @brief A texture as handed out by the TextureManager.
+ */
+struct ManagedTexture
+{
+    GLuint id = 0;
+    int width = 0;
+    int height = 0;
+    bool ready = false;     // False while the placeholder is returned
+
+    ImTextureID TexID() const
+    {
+        return (ImTextureID)(intptr_t)id;
+    }
+};
+
+/**
+ * @brief Loads textures without stalling the UI thread.
+ *
+ * Files are read, hashed and decoded on a small worker pool. Decoded
+ * images are uploaded a few rows at a time from Update(), through a
+ * ring of pixel buffer objects where the GL version has them, so no
+ * frame uploads more than upload_budget bytes. Textures are cached by
+ * path, and by content hash so identical images share one GL texture.
+ * Until a texture is ready Get() returns a small placeholder.
+ */
+class TextureManager
+{
+public:
+    static const int DEFAULT_WORKERS = 2;
+    static const size_t DEFAULT_UPLOAD_BUDGET = 1 << 20;    // Bytes per frame
+    static const int PBO_COUNT = 3;
+
+    TextureManager() = default;
+    TextureManager(const TextureManager&) = delete;
+    TextureManager& operator=(const TextureManager&) = delete;
+
+    ~TextureManager()
+    {
+        Shutdown();
+    }
+
+    /**
+     * @brief Create the placeholder and upload buffers and start the
+     * workers. Needs a current GL context.
+     */
+    void Init(
+        const int worker_count = DEFAULT_WORKERS,
+        const size_t budget = DEFAULT_UPLOAD_BUDGET)
+    {
+        upload_budget = std::max(budget, (size_t)4096);
+
+        // Grey checkerboard, shown until a texture is ready
+        const uint32_t grey = IM_COL32(96, 96, 96, 255);
+        const uint32_t light = IM_COL32(160, 160, 160, 255);
+        const uint32_t pixels[4] = { grey, light, light, grey };
+
+        glGenTextures(1, &placeholder.id);
+        glBindTexture(GL_TEXTURE_2D, placeholder.id);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 2, 2, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        placeholder.width = 2;
+        placeholder.height = 2;
+
+        if (LoadGLBufferProcs() == true)
+        {
+            GLProcs& gl = GetGLProcs();
+            gl.GenBuffers(PBO_COUNT, pbos);
+            for (int ii = 0;
+                ii < PBO_COUNT;
+                ii++)
+            {
+                gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, pbos[ii]);
+                gl.BufferData(GL_PIXEL_UNPACK_BUFFER, (ptrdiff_t)upload_budget, NULL, GL_STREAM_DRAW);
+            }
+            gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            use_pbos = true;
+        }
+
+        running = true;
+        for (int ii = 0;
+            ii < std::max(worker_count, 1);
+            ii++)
+        {
+            workers.emplace_back(
+                &TextureManager::WorkerLoop,
+                this);
+        }
+    }
+
+    /**
+     * @brief Stop the workers and delete every GL object. Needs the GL context.
+     */
+    void Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        wake_workers.notify_all();
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+        workers.clear();
+
+        for (Decoded& decoded : decoded_queue)
+        {
+            stbi_image_free(decoded.pixels);
+        }
+        decoded_queue.clear();
+        for (Upload& upload : uploads)
+        {
+            stbi_image_free(upload.pixels);
+        }
+        uploads.clear();
+
+        for (ManagedTexture& texture : textures)
+        {
+            if (texture.id != 0)
+            {
+                glDeleteTextures(1, &texture.id);
+            }
+        }
+        textures.clear();
+        generations.clear();
+        owned_hashes.clear();
+        free_slots.clear();
+        by_path.clear();
+        by_hash.clear();
+        aliases.clear();
+        jobs.clear();
+        seen_hashes.clear();
+
+        if (placeholder.id != 0)
+        {
+            glDeleteTextures(1, &placeholder.id);
+            placeholder = ManagedTexture();
+        }
+
+        if (use_pbos == true)
+        {
+            GetGLProcs().DeleteBuffers(PBO_COUNT, pbos);
+            use_pbos = false;
+        }
+    }
+
+    /**
+     * @brief Called from a worker thread whenever a decode finishes,
+     * so an idle main loop can wake up and upload it.
+     */
+    void SetWakeCallback(
+        void (*callback)())
+    {
+        wake_callback = callback;
+    }
+
+    /**
+     * @brief Texture for an image file. The first call queues the load,
+     * the placeholder is returned until the texture is fully uploaded.
+     */
+    ManagedTexture Get(
+        const std::string& path)
+    {
+        return Request(
+            path,
+            NULL,
+            0);
+    }
+
+    /**
+     * @brief Texture for an encoded image already in memory, cached
+     * under key. The data must stay valid until the texture is ready
+     * or released, e.g. because it lives in a memory-mapped file.
+     */
+    ManagedTexture GetMemory(
+        const std::string& key,
+        const unsigned char* data,
+        const size_t size)
+    {
+        return Request(
+            key,
+            data,
+            size);
+    }
+
+    /**
+     * @brief Forget a texture, deleting its GL texture unless another
+     * key shares it. Loads still in flight for it are discarded, and if
+     * a worker is reading its GetMemory() data this waits for it, so the
+     * data can be freed or unmapped once this returns.
+     */
+    void Release(
+        const std::string& key)
+    {
+        auto it = by_path.find(key);
+        if (it == by_path.end())
+        {
+            return;
+        }
+
+        int slot = it->second;
+        by_path.erase(it);
+        for (const auto& entry : by_path)
+        {
+            if (entry.second == slot)
+            {
+                return;
+            }
+        }
+
+        FreeSlot(slot);
+    }
+
+    /**
+     * @brief True while decoded images are still being uploaded.
+     * Decodes finishing are reported through the wake callback.
+     */
+    bool Uploading() const
+    {
+        return uploads.empty() == false;
+    }
+
+    /**
+     * @brief Upload decoded images, at most the upload budget per call.
+     * Call once per frame on the thread owning the GL context.
+     */
+    void Update()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            decoded_swap.swap(decoded_queue);
+        }
+
+        for (Decoded& decoded : decoded_swap)
+        {
+            Accept(decoded);
+        }
+        decoded_swap.clear();
+
+        size_t budget = upload_budget;
+        while (budget > 0 &&
+            uploads.empty() == false)
+        {
+            Upload& upload = uploads.front();
+            budget -= UploadRows(
+                upload,
+                budget);
+
+            if (upload.next_row == upload.height)
+            {
+                ManagedTexture& texture = textures[upload.slot];
+                texture.ready = true;
+                stbi_image_free(upload.pixels);
+                uploads.pop_front();
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief A load for one slot. Reads path unless data is set.
+     */
+    struct Job
+    {
+        std::string path;
+        const unsigned char* data;
+        size_t size;
+        int slot;
+        uint32_t generation;
+    };
+
+    /**
+     * @brief A slot whose content turned out to be loading elsewhere.
+     */
+    struct Alias
+    {
+        Job job;
+        uint64_t hash;
+    };
+
+    /**
+     * @brief Worker output. pixels is NULL if the file failed to load
+     * (hash is 0 too) or its content was already being loaded for
+     * another slot.
+     */
+    struct Decoded
+    {
+        Job job;
+        uint64_t hash;
+        unsigned char* pixels;
+        int width;
+        int height;
+    };
+
+    struct Upload
+    {
+        int slot;
+        unsigned char* pixels;
+        int width;
+        int height;
+        int next_row;
+    };
+
+    ManagedTexture placeholder;
+    std::vector<ManagedTexture> textures;               // Slot -> texture
+    std::vector<uint32_t> generations;                  // Slot -> reuse count, to discard stale loads
+    std::vector<uint64_t> owned_hashes;                 // Slot -> hash of the content it owns, 0 if none
+    std::vector<int> free_slots;
+    std::unordered_map<std::string, int> by_path;       // Path or key -> slot
+    std::unordered_map<uint64_t, int> by_hash;          // Content hash -> slot owning the GL texture
+    std::vector<Alias> aliases;                         // Slots waiting for another slot with the same content
+    std::deque<Upload> uploads;
+    size_t upload_budget = DEFAULT_UPLOAD_BUDGET;
+
+    GLuint pbos[PBO_COUNT] = {};
+    int next_pbo = 0;
+    bool use_pbos = false;
+
+    // Shared with the workers, guarded by mutex
+    std::mutex mutex;
+    std::condition_variable wake_workers;
+    std::condition_variable read_done;
+    std::deque<Job> jobs;
+    std::vector<int> reading;                           // Slots whose caller memory a worker is reading
+    std::vector<Decoded> decoded_queue;
+    std::unordered_set<uint64_t> seen_hashes;
+    bool running = false;
+
+    std::vector<Decoded> decoded_swap;                  // UI thread scratch
+    std::vector<std::thread> workers;
+    void (*wake_callback)() = NULL;
+
+    static uint64_t HashBytes(
+        const unsigned char* data,
+        const size_t size)
+    {
+        // FNV-1a
+        uint64_t hash = 1469598103934665603ull;
+        for (size_t ii = 0;
+            ii < size;
+            ii++)
+        {
+            hash = (hash ^ data[ii]) * 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    ManagedTexture Request(
+        const std::string& key,
+        const unsigned char* data,
+        const size_t size)
+    {
+        auto it = by_path.find(key);
+        if (it != by_path.end())
+        {
+            const ManagedTexture& texture = textures[it->second];
+            return texture.ready == true ?
+                texture :
+                placeholder;
+        }
+
+        int slot;
+        if (free_slots.empty() == false)
+        {
+            slot = free_slots.back();
+            free_slots.pop_back();
+        }
+        else
+        {
+            slot = (int)textures.size();
+            textures.push_back(ManagedTexture());
+            generations.push_back(0);
+            owned_hashes.push_back(0);
+        }
+        by_path.emplace(key, slot);
+
+        Job job;
+        job.path = key;
+        job.data = data;
+        job.size = size;
+        job.slot = slot;
+        job.generation = generations[slot];
+        Enqueue(job);
+        return placeholder;
+    }
+
+    void Enqueue(
+        const Job& job)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(job);
+        wake_workers.notify_one();
+    }
+
+    /**
+     * @brief Delete a slot's texture and make it reusable. Results
+     * still in flight for it no longer match its generation.
+     */
+    void FreeSlot(
+        const int slot)
+    {
+        ManagedTexture& texture = textures[slot];
+        if (texture.id != 0)
+        {
+            glDeleteTextures(1, &texture.id);
+        }
+        texture = ManagedTexture();
+
+        for (size_t ii = 0;
+            ii < uploads.size();
+            ii++)
+        {
+            if (uploads[ii].slot == slot)
+            {
+                stbi_image_free(uploads[ii].pixels);
+                uploads.erase(uploads.begin() + ii);
+                break;
+            }
+        }
+
+        // Nothing may read the slot's memory once it's released
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobs.erase(
+                std::remove_if(
+                    jobs.begin(),
+                    jobs.end(),
+                    [slot](const Job& job) { return job.slot == slot; }),
+                jobs.end());
+
+            read_done.wait(lock, [this, slot]()
+            {
+                return std::find(reading.begin(), reading.end(), slot) == reading.end();
+            });
+        }
+
+        uint64_t hash = owned_hashes[slot];
+        if (hash != 0)
+        {
+            by_hash.erase(hash);
+            owned_hashes[slot] = 0;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                seen_hashes.erase(hash);
+            }
+
+            RequeueAliases(hash);
+        }
+
+        generations[slot]++;
+        free_slots.push_back(slot);
+    }
+
+    /**
+     * @brief Slots that were waiting on content nobody loads anymore
+     * have to load it themselves, unless they were released meanwhile.
+     */
+    void RequeueAliases(
+        const uint64_t hash)
+    {
+        for (size_t ii = 0;
+            ii < aliases.size();
+            )
+        {
+            if (aliases[ii].hash != hash)
+            {
+                ii++;
+                continue;
+            }
+
+            const Job& job = aliases[ii].job;
+            if (job.generation == generations[job.slot])
+            {
+                Enqueue(job);
+            }
+            aliases[ii] = aliases.back();
+            aliases.pop_back();
+        }
+    }
+
+    void WorkerLoop()
+    {
+        std::vector<unsigned char> file_data;
+
+        while (true)
+        {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake_workers.wait(lock, [this]() { return running == false || jobs.empty() == false; });
+                if (running == false)
+                {
+                    return;
+                }
+
+                job = jobs.front();
+                jobs.pop_front();
+                if (job.data != NULL)
+                {
+                    reading.push_back(job.slot);
+                }
+            }
+
+            Decoded decoded;
+            decoded.job = job;
+            decoded.hash = 0;
+            decoded.pixels = NULL;
+            decoded.width = 0;
+            decoded.height = 0;
+
+            const unsigned char* data = job.data;
+            size_t size = job.size;
+            bool loaded = data != NULL;
+            if (loaded == false)
+            {
+                loaded = ReadFile(
+                    job.path,
+                    file_data);
+
+                data = file_data.data();
+                size = file_data.size();
+            }
+
+            bool duplicate = false;
+            if (loaded == true)
+            {
+                decoded.hash = HashBytes(
+                    data,
+                    size);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                duplicate = seen_hashes.insert(decoded.hash).second == false;
+            }
+
+            if (loaded == true &&
+                duplicate == false)
+            {
+                decoded.pixels = stbi_load_from_memory(
+                    data,
+                    (int)size,
+                    &decoded.width,
+                    &decoded.height,
+                    NULL,
+                    4);
+            }
+
+            if (job.data != NULL)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    reading.erase(std::find(reading.begin(), reading.end(), job.slot));
+                }
+                read_done.notify_all();
+            }
+
+            if (loaded == false ||
+                (duplicate == false && decoded.pixels == NULL))
+            {
+                fprintf(stderr, "Lo-RISE: can't load texture %s\n", job.path.c_str());
+                if (loaded == true)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    seen_hashes.erase(decoded.hash);
+                }
+                decoded.hash = 0;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                decoded_queue.push_back(decoded);
+            }
+
+            if (wake_callback != NULL)
+            {
+                wake_callback();
+            }
+        }
+    }
+
+    static bool ReadFile(
+        const std::string& path,
+        std::vector<unsigned char>& data)
+    {
+        FILE* f = fopen(path.c_str(), "rb");
+        if (f == NULL)
+        {
+            return false;
+        }
+
+        fseek(f, 0, SEEK_END);
+        long size = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        if (size <= 0)
+        {
+            fclose(f);
+            return false;
+        }
+
+        data.resize((size_t)size);
+        size_t read = fread(data.data(), 1, data.size(), f);
+        fclose(f);
+        return read == data.size();
+    }
+
+    /**
+     * @brief Take a worker result: start uploading it, or point
+     * the slot at the texture already holding the same content.
+     */
+    void Accept(
+        Decoded& decoded)
+    {
+        if (decoded.job.generation != generations[decoded.job.slot])
+        {
+            // Released while loading, let the content load again later
+            if (decoded.pixels != NULL)
+            {
+                stbi_image_free(decoded.pixels);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    seen_hashes.erase(decoded.hash);
+                }
+                RequeueAliases(decoded.hash);
+            }
+            return;
+        }
+
+        if (decoded.pixels == NULL)
+        {
+            if (decoded.hash != 0)
+            {
+                bool loading;
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    loading = seen_hashes.count(decoded.hash) != 0;
+                }
+
+                if (loading == true ||
+                    by_hash.count(decoded.hash) != 0)
+                {
+                    Alias alias;
+                    alias.job = decoded.job;
+                    alias.hash = decoded.hash;
+                    aliases.push_back(alias);
+                }
+                else
+                {
+                    // The slot holding this content was released before it finished
+                    Enqueue(decoded.job);
+                }
+            }
+        }
+        else
+        {
+            by_hash[decoded.hash] = decoded.job.slot;
+            owned_hashes[decoded.job.slot] = decoded.hash;
+
+            ManagedTexture& texture = textures[decoded.job.slot];
+            texture.width = decoded.width;
+            texture.height = decoded.height;
+
+            glGenTextures(1, &texture.id);
+            glBindTexture(GL_TEXTURE_2D, texture.id);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texture.width, texture.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+            Upload upload;
+            upload.slot = decoded.job.slot;
+            upload.pixels = decoded.pixels;
+            upload.width = decoded.width;
+            upload.height = decoded.height;
+            upload.next_row = 0;
+            uploads.push_back(upload);
+        }
+
+        // Aliases resolve once their content has a slot, and share its GL texture
+        for (size_t ii = 0;
+            ii < aliases.size();
+            )
+        {
+            auto owner = by_hash.find(aliases[ii].hash);
+            if (owner == by_hash.end())
+            {
+                ii++;
+                continue;
+            }
+
+            // The waiting slot is dropped for the owner, unless it was released meanwhile
+            int slot = aliases[ii].job.slot;
+            if (aliases[ii].job.generation == generations[slot])
+            {
+                RemapPaths(
+                    slot,
+                    owner->second);
+                FreeSlot(slot);
+            }
+            aliases[ii] = aliases.back();
+            aliases.pop_back();
+        }
+    }
+
+    /**
+     * @brief Point every path using slot at the target slot instead.
+     */
+    void RemapPaths(
+        const int slot,
+        const int target)
+    {
+        for (auto& entry : by_path)
+        {
+            if (entry.second == slot)
+            {
+                entry.second = target;
+            }
+        }
+    }
+
+    /**
+     * @brief Upload as many whole rows as fit in the budget,
+     * at least one. Returns the bytes uploaded.
+     */
+    size_t UploadRows(
+        Upload& upload,
+        const size_t budget)
+    {
+        size_t row_bytes = (size_t)upload.width * 4;
+        int rows = (int)std::min(
+            (size_t)(upload.height - upload.next_row),
+            std::max(budget / row_bytes, (size_t)1));
+
+        // Rows wider than a buffer go straight from client memory
+        bool via_pbo = use_pbos == true &&
+            row_bytes * rows <= upload_budget;
+
+        const unsigned char* src = upload.pixels + row_bytes * upload.next_row;
+        size_t bytes = row_bytes * rows;
+
+        glBindTexture(GL_TEXTURE_2D, textures[upload.slot].id);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        if (via_pbo == true)
+        {
+            GLProcs& gl = GetGLProcs();
+            gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, pbos[next_pbo]);
+            next_pbo = (next_pbo + 1) % PBO_COUNT;
+
+            // Invalidating lets the driver hand out fresh storage instead of waiting on the GPU
+            void* dst = gl.MapBufferRange(
+                GL_PIXEL_UNPACK_BUFFER,
+                0,
+                (ptrdiff_t)bytes,
+                GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+            if (dst != NULL)
+            {
+                memcpy(dst, src, bytes);
+                gl.UnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+                src = NULL;
+            }
+            else
+            {
+                gl.BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            }
+        }
+
+        // With a PBO bound, the pointer is an offset into it
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, upload.next_row, upload.width, rows, GL_RGBA, GL_UNSIGNED_BYTE, src);
+
+        if (via_pbo == true)
+        {
+            GetGLProcs().BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+
+        upload.next_row += rows;
+        return std::min(bytes, budget);
+    }
+};
@@ -0,0 +1,290 @@
+#pragma once
+
+// Standard library includes
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ImGui includes
+#include "imgui.h"
+
+// Lo-RISE includes
+#include "camera.h"
+#include "entity_store.h"
+
+/**
+ * @brief Screen positions of every entity in a store, by entity index.
+ */
+struct ScreenPositions
+{
+    std::vector<float> x;
+    std::vector<float> y;
+
+    ImVec2 Get(
+        const int index) const
+    {
+        return ImVec2(
+            x[index],
+            y[index]);
+    }
+};
+
+/**
+ * @brief What the ImGui pass reads to draw one frame's entities.
+ */
+struct RenderSnapshot
+{
+    ScreenPositions agents;
+    ScreenPositions tactics;
+};
+
+/**
+ * @brief World positions to transform, as separate x and y arrays.
+ * Converts from an EntityStore, or points at eased positions.
+ */
+struct WorldPositions
+{
+    const float* x = NULL;
+    const float* y = NULL;
+    int count = 0;
+
+    WorldPositions(
+        const float* world_x,
+        const float* world_y,
+        const int world_count) :
+        x(world_x),
+        y(world_y),
+        count(world_count)
+    {
+    }
+
+    WorldPositions(
+        const EntityStore& store) :
+        x(store.x.data()),
+        y(store.y.data()),
+        count(store.Size())
+    {
+    }
+};
+
+/**
+ * @brief Per-frame pipeline stage transforming every entity from world
+ * to screen space across worker threads.
+ *
+ * Begin() hands the transform to the workers and returns, so the UI
+ * thread can build the rest of the frame meanwhile. End() joins in on
+ * whatever is left, waits, and swaps the double-buffered snapshot.
+ * Front() is only ever read, and stays valid (as last frame's result)
+ * while the back buffer is being written. World positions must not change
+ * between Begin() and End().
+ */
+class WorldUpdateStage
+{
+public:
+    static const int CHUNK_SIZE = 16384;            // Entities per work item
+    static const int PARALLEL_MIN = 2 * CHUNK_SIZE; // Fewer entities are transformed inline
+
+    /**
+     * @brief Negative worker_count uses one worker per spare core.
+     */
+    explicit WorldUpdateStage(
+        int worker_count = -1)
+    {
+        if (worker_count < 0)
+        {
+            worker_count = std::max((int)std::thread::hardware_concurrency() - 1, 0);
+        }
+
+        for (int ii = 0;
+            ii < worker_count;
+            ii++)
+        {
+            workers.emplace_back(
+                &WorldUpdateStage::WorkerLoop,
+                this);
+        }
+    }
+
+    WorldUpdateStage(const WorldUpdateStage&) = delete;
+    WorldUpdateStage& operator=(const WorldUpdateStage&) = delete;
+
+    ~WorldUpdateStage()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        wake_workers.notify_all();
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief Start transforming agents and tactics with the given camera.
+     * Screen positions include the window origin.
+     */
+    void Begin(
+        const WorldPositions& agents,
+        const WorldPositions& tactics,
+        const ImVec2 origin,
+        const ImVec2 center,
+        const ImVec2 camera_pan,
+        const float camera_zoom)
+    {
+        camera = CameraTransform(
+            origin,
+            center,
+            camera_pan,
+            camera_zoom);
+
+        SetTarget(0, agents, back.agents);
+        SetTarget(1, tactics, back.tactics);
+        agent_chunks = (agents.count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        chunk_count = agent_chunks + (tactics.count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        done_chunks.store(0, std::memory_order_relaxed);
+
+        // Publishing the claim counter releases the setup above to whoever claims a chunk
+        next_chunk.store((uint64_t)chunk_count << 32, std::memory_order_release);
+        if (workers.empty() == true ||
+            agents.count + tactics.count < PARALLEL_MIN)
+        {
+            RunChunks();
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            generation++;
+        }
+        wake_workers.notify_all();
+    }
+
+    /**
+     * @brief Finish the transform and publish it. Returns the new front.
+     */
+    const RenderSnapshot& End()
+    {
+        RunChunks();
+        while (done_chunks.load(std::memory_order_acquire) < chunk_count)
+        {
+            std::this_thread::yield();
+        }
+
+        std::swap(
+            front,
+            back);
+
+        return front;
+    }
+
+    /**
+     * @brief Last published snapshot.
+     */
+    const RenderSnapshot& Front() const
+    {
+        return front;
+    }
+
+private:
+    /**
+     * @brief Source and destination arrays of one store.
+     */
+    struct Target
+    {
+        const float* world_x = NULL;
+        const float* world_y = NULL;
+        float* screen_x = NULL;
+        float* screen_y = NULL;
+        int count = 0;
+    };
+
+    RenderSnapshot front;
+    RenderSnapshot back;
+    Target targets[2];                      // Agents, tactics
+    int agent_chunks = 0;
+    CameraTransform camera;
+
+    int chunk_count = 0;                    // Chunks this frame, only touched by the UI thread
+
+    // Next chunk to claim in the low 32 bits, and the frame's chunk count in the high
+    // 32 bits. A claim carries the count of the frame it was made in, so one made after
+    // that frame ran out of chunks fails even while Begin() sets up the next frame.
+    std::atomic<uint64_t> next_chunk{0};
+    std::atomic<int> done_chunks{0};
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake_workers;
+    uint64_t generation = 0;
+    bool running = true;
+
+    void SetTarget(
+        const int target,
+        const WorldPositions& world,
+        ScreenPositions& screen)
+    {
+        screen.x.resize(world.count);
+        screen.y.resize(world.count);
+
+        targets[target].world_x = world.x;
+        targets[target].world_y = world.y;
+        targets[target].screen_x = screen.x.data();
+        targets[target].screen_y = screen.y.data();
+        targets[target].count = world.count;
+    }
+
+    /**
+     * @brief Transform chunks until none are left. Run by the workers
+     * and by the UI thread in End().
+     */
+    void RunChunks()
+    {
+        // Claiming acquires the setup of the frame the claim belongs to
+        uint64_t claim = next_chunk.fetch_add(1, std::memory_order_acquire);
+        while ((uint32_t)claim < (uint32_t)(claim >> 32))
+        {
+            const int chunk = (int)(uint32_t)claim;
+            const Target& target = chunk < agent_chunks ?
+                targets[0] :
+                targets[1];
+
+            int start = (chunk < agent_chunks ? chunk : chunk - agent_chunks) * CHUNK_SIZE;
+            int end = std::min(start + CHUNK_SIZE, target.count);
+            WorldToScreen(
+                camera,
+                target.world_x + start,
+                target.world_y + start,
+                target.screen_x + start,
+                target.screen_y + start,
+                end - start);
+
+            done_chunks.fetch_add(1, std::memory_order_release);
+            claim = next_chunk.fetch_add(1, std::memory_order_acquire);
+        }
+    }
+
+    void WorkerLoop()
+    {
+        uint64_t seen_generation = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake_workers.wait(lock, [&]() { return running == false || generation != seen_generation; });
+                if (running == false)
+                {
+                    return;
+                }
+                seen_generation = generation;
+            }
+
+            RunChunks();
+        }
+    }
+};